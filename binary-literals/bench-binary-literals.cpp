@@ -0,0 +1,326 @@
+#include "binary-literals.hpp"
+#include "bulk.hpp"
+#include "decoder.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+
+template <typename F>
+double elapsed(F&& f, size_t& checksum) {
+	auto start = std::chrono::steady_clock::now();
+	checksum = f();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+template <typename F>
+void throughput(const char* name, size_t bytes, F&& f) {
+	size_t checksum;
+	double ns = elapsed(f, checksum);
+	std::printf("  %-40s %10.2f GB/s   (checksum %zu)\n", name, bytes / ns, checksum);
+}
+
+
+// The loop of the original operator"" _bULL(const char*, size_t).
+unsigned long long loop(const char* s, size_t sz) {
+	unsigned long long value = 0;
+	for(size_t i = 0; i < sz; i++) {
+		char ch = s[i];
+		if(ch == '0') {
+			value = (value << 1);
+		} else if(ch == '1') {
+			value = (value << 1) | 1;
+		} else if(ch != '_') {
+			throw "Not a binary digit";
+		}
+	}
+	return value;
+}
+
+
+struct records {
+	std::string text;
+	std::vector<size_t> offsets;
+
+	size_t count() const { return offsets.size() - 1; }
+	const char* data(size_t i) const { return text.data() + offsets[i]; }
+	size_t size(size_t i) const { return offsets[i + 1] - offsets[i]; }
+};
+
+records makeRecords(size_t bytes, size_t digits) {
+	std::mt19937 random(42);
+	records result;
+	result.text.reserve(bytes + 128);
+	while(result.text.size() < bytes) {
+		result.offsets.push_back(result.text.size());
+		size_t n = 1 + random() % digits;
+		size_t group = 4 + random() % 5;
+		for(size_t i = 0; i < n; i++) {
+			if(i > 0 && i % group == 0 && random() % 2 == 0) {
+				result.text += '_';
+			}
+			result.text += char('0' + random() % 2);
+		}
+	}
+	result.offsets.push_back(result.text.size());
+	return result;
+}
+
+
+// Replaces one character of percent% of the records by an invalid one.
+void corrupt(records& input, unsigned percent) {
+	std::mt19937 random(7);
+	for(size_t i = 0; i < input.count(); i++) {
+		if(random() % 100 < percent) {
+			input.text[input.offsets[i] + random() % input.size(i)] = 'x';
+		}
+	}
+}
+
+
+void benchParse(size_t mebibytes, size_t digits) {
+	records input = makeRecords(mebibytes << 20, digits);
+	std::printf("binary digits (%zu MiB, %zu records of 1-%zu digits)\n", mebibytes, input.count(), digits);
+	throughput("binary_literals::parse", input.text.size(), [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < input.count(); i++) {
+			sum += binary_literals::parse(input.data(i), input.size(i)).value;
+		}
+		return sum;
+	});
+	throughput("original _bULL loop", input.text.size(), [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < input.count(); i++) {
+			sum += loop(input.data(i), input.size(i));
+		}
+		return sum;
+	});
+}
+
+
+void benchMalformed(size_t mebibytes, unsigned percent) {
+	records input = makeRecords(mebibytes << 20, 64);
+	corrupt(input, percent);
+	std::printf("binary digits (%zu MiB, %zu records of 1-64 digits, %u%% malformed)\n", mebibytes, input.count(), percent);
+	throughput("binary_literals::parse", input.text.size(), [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < input.count(); i++) {
+			binary_literals::result r = binary_literals::parse(input.data(i), input.size(i));
+			sum += r ? r.value : r.position;
+		}
+		return sum;
+	});
+	throughput("original _bULL loop, catching", input.text.size(), [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < input.count(); i++) {
+			try {
+				sum += loop(input.data(i), input.size(i));
+			} catch(const char*) {
+				sum++;
+			}
+		}
+		return sum;
+	});
+}
+
+
+// Newline-terminated records, so that strtoull stops at their end.
+template <unsigned Base>
+records makeRadixRecords(size_t bytes, size_t digits) {
+	const char alphabet[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+	std::mt19937 random(42);
+	records result;
+	result.text.reserve(bytes + 128);
+	while(result.text.size() < bytes) {
+		result.offsets.push_back(result.text.size());
+		size_t n = 1 + random() % digits;
+		for(size_t i = 0; i < n; i++) {
+			result.text += alphabet[random() % Base];
+		}
+		result.text += '\n';
+	}
+	result.offsets.push_back(result.text.size());
+	return result;
+}
+
+
+template <unsigned Base>
+void benchRadix(size_t mebibytes, size_t digits) {
+	records input = makeRadixRecords<Base>(mebibytes << 20, digits);
+	std::printf("base %u digits (%zu MiB, %zu records of 1-%zu digits)\n", Base, mebibytes, input.count(), digits);
+	throughput("binary_literals::parse<Base>", input.text.size(), [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < input.count(); i++) {
+			sum += binary_literals::parse<Base>(input.data(i), input.size(i) - 1).value;
+		}
+		return sum;
+	});
+	throughput("strtoull", input.text.size(), [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < input.count(); i++) {
+			sum += std::strtoull(input.data(i), nullptr, Base);
+		}
+		return sum;
+	});
+#if __cplusplus >= 201703L
+	throughput("std::from_chars", input.text.size(), [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < input.count(); i++) {
+			unsigned long long value = 0;
+			std::from_chars(input.data(i), input.data(i) + input.size(i) - 1, value, Base);
+			sum += value;
+		}
+		return sum;
+	});
+#endif
+}
+
+
+// A MIPS-like table of 200 rules on 32-bit words: 160 register forms told
+// apart by their opcode and function fields, some of which require a zero
+// shift amount, then 40 immediate forms with an opcode only.
+constexpr binary_literals::pattern isaPattern(size_t i) {
+	if(i < 160) {
+		std::uint64_t shift = (i % 3 == 0) ? 0x7C0 : 0;
+		return binary_literals::pattern{ 0xFC00003F | shift, ((i / 32) << 26) | ((i % 32) * 2) };
+	}
+	return binary_literals::pattern{ 0xFC000000, (8 + i - 160) << 26 };
+}
+
+template <size_t I>
+std::uint64_t execute(std::uint64_t w) {
+	return (w >> (I % 7)) + I;
+}
+
+struct Isa {
+	template <size_t... I>
+	static constexpr auto rules(std::index_sequence<I...>) {
+		return binary_literals::rules(binary_literals::on(isaPattern(I), &execute<I>)...);
+	}
+
+	static constexpr auto rules() {
+		return rules(std::make_index_sequence<200>());
+	}
+};
+
+
+void benchDecoder(size_t count) {
+	using decoder = binary_literals::decoder<Isa>;
+	std::mt19937 random(42);
+	std::vector<std::uint32_t> words(count);
+	for(std::uint32_t& w : words) {
+		const binary_literals::pattern& p = decoder::rules[random() % decoder::size].match;
+		w = (random() % 20 == 0) ? std::uint32_t(random()) : std::uint32_t(p.value | (random() & ~p.mask));
+	}
+	std::printf("decoding (%zu words, %d rules, %d tree nodes)\n", count, int(decoder::size), int(decoder::node_count));
+	auto run = [&](const char* name, auto&& find) {
+		size_t checksum;
+		double ns = elapsed([&] {
+			size_t sum = 0;
+			for(std::uint32_t w : words) {
+				auto r = find(w);
+				sum += r ? r->handler(w) : 1;
+			}
+			return sum;
+		}, checksum);
+		std::printf("  %-40s %10.2f ns/word (checksum %zu)\n", name, ns / count, checksum);
+	};
+	run("decoder::find", [](std::uint32_t w) {
+		return decoder::find(w);
+	});
+	run("linear scan", [](std::uint32_t w) -> const decoder::rule_type* {
+		for(size_t k = 0; k < decoder::size; k++) {
+			if(decoder::rules[k].match.matches(w)) {
+				return &decoder::rules[k];
+			}
+		}
+		return nullptr;
+	});
+}
+
+
+long peakKib() {
+	struct rusage usage;
+	::getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+// Writes the records of makeRecords(), one per line, a piece at a time.
+void writeRecords(const char* path, size_t mebibytes) {
+	std::ofstream out(path, std::ios::binary);
+	for(size_t i = 0; i < mebibytes; i += 16) {
+		records piece = makeRecords(size_t(16) << 20, 64);
+		std::string text;
+		text.reserve(piece.text.size() + piece.count());
+		for(size_t k = 0; k < piece.count(); k++) {
+			text.append(piece.data(k), piece.size(k));
+			text += '\n';
+		}
+		out.write(text.data(), text.size());
+	}
+}
+
+void benchBulk(size_t mebibytes) {
+	const char* path = "bench-binary-literals.records";
+	writeRecords(path, mebibytes);
+	{
+		binary_literals::mapped_file file(path);
+		size_t count = binary_literals::count_records(file.data(), file.size());
+		std::vector<std::uint64_t> values(count);
+		unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+		std::printf("bulk records (%zu MiB file, %zu records, %u cores)\n", file.size() >> 20, count, cores);
+		for(unsigned threads = 1; threads <= std::max(4u, cores); threads *= 2) {
+			char name[64];
+			std::snprintf(name, sizeof(name), "parse_records, %u threads", threads);
+			throughput(name, file.size(), [&] {
+				binary_literals::parse_records(file.data(), file.size(), values.data(), threads);
+				size_t sum = 0;
+				for(std::uint64_t v : values) {
+					sum += v;
+				}
+				return sum;
+			});
+			std::snprintf(name, sizeof(name), "for_each_record, %u threads", threads);
+			throughput(name, file.size(), [&] {
+				std::atomic<size_t> sum(0);
+				binary_literals::for_each_record(file.data(), file.size(), threads, [&](size_t, const binary_literals::result& r) {
+					sum.fetch_add(r.value, std::memory_order_relaxed);
+				});
+				return sum.load();
+			});
+		}
+		std::printf("  %-40s %10ld KiB\n", "peak RSS", peakKib());
+	}
+	std::remove(path);
+}
+
+
+int main(int argc, char* argv[]) {
+	size_t mebibytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1024;
+
+	// First, so that the peak RSS it reports is its own.
+	benchBulk(mebibytes / 2);
+	benchParse(mebibytes, 64);
+	benchParse(mebibytes, 16);
+	// Throwing is too slow to go through the full size at high error rates.
+	for(unsigned percent : { 1, 10, 50 }) {
+		benchMalformed(mebibytes / 16, percent);
+	}
+	benchDecoder(mebibytes << 14);
+	benchRadix<16>(mebibytes / 4, 16);
+	benchRadix<8>(mebibytes / 4, 21);
+	benchRadix<36>(mebibytes / 4, 12);
+}
@@ -0,0 +1,550 @@
+#ifndef BINARY_LITERALS_HPP_
+#define BINARY_LITERALS_HPP_
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+
+namespace binary_literals {
+
+
+enum { NOT_FOUND = static_cast<size_t>(-1) };
+
+enum class error { none, invalid_digit, overflow, empty };
+
+// On error, value holds the digits before position, the offending character
+// (or the end of the input when it has no digits at all).
+struct result {
+	std::uint64_t value;
+	error code;
+	size_t position;
+
+	explicit operator bool() const {
+		return code == error::none;
+	}
+};
+
+// A word matches when its bits under mask equal value.
+struct pattern {
+	std::uint64_t mask;
+	std::uint64_t value;
+
+	constexpr bool matches(std::uint64_t word) const {
+		return (word & mask) == value;
+	}
+};
+
+
+namespace __impl {
+
+
+	// Reverses the bits of x, so that the first character of a chunk (bit 0
+	// of a movemask) becomes the most significant digit.
+	inline std::uint32_t reverse(std::uint32_t x) {
+		x = __builtin_bswap32(x);
+		x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+		x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+		x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+		return x;
+	}
+
+	// Appends the digits of a chunk of Width characters, given as movemasks
+	// of the '1' characters and of all digit characters.
+	template <int Width>
+	inline std::uint64_t append(std::uint64_t value, std::uint32_t ones, std::uint32_t digits) {
+		std::uint32_t bits = reverse(ones) >> (32 - Width);
+		std::uint32_t selected = reverse(digits) >> (32 - Width);
+		int count = __builtin_popcount(digits);
+		if(count == Width) {
+			return (value << Width) | bits;
+		}
+#if defined(__BMI2__)
+		return (count == 0) ? value : (value << count) | _pext_u32(bits, selected);
+#else
+		for(int i = Width - 1; i >= 0; i--) {
+			std::uint64_t d = (selected >> i) & 1;
+			value = (value << d) | ((bits >> i) & d);
+		}
+		return value;
+#endif
+	}
+
+	inline error scalar(const char* s, size_t n, std::uint64_t& value, size_t& position) {
+		for(size_t i = 0; i < n; i++) {
+			unsigned char c = static_cast<unsigned char>(s[i]);
+			std::uint64_t d = (c == '0') | (c == '1');
+			if(!d && c != '_') {
+				position = i;
+				return error::invalid_digit;
+			}
+			if((value >> 63) & d) {
+				position = i;
+				return error::overflow;
+			}
+			value = (value << d) | (c & d);
+		}
+		return error::none;
+	}
+
+	// Appends the length characters of the chunk at s + i and returns true
+	// when they end the parse. A chunk that overflows is walked again to find
+	// the offending digit.
+	template <int Width>
+	inline bool step(const char* s, size_t i, size_t length, std::uint32_t ones, std::uint32_t digits, std::uint32_t invalid, result& r) {
+		if(invalid != 0) {
+			length = __builtin_ctz(invalid);
+			std::uint32_t before = (1u << length) - 1;
+			ones &= before;
+			digits &= before;
+		}
+		int count = __builtin_popcount(digits);
+		if(count != 0 && (r.value >> (64 - count)) != 0) {
+			r.code = scalar(s + i, length, r.value, r.position);
+			r.position += i;
+			return true;
+		}
+		r.value = append<Width>(r.value, ones, digits);
+		if(invalid != 0) {
+			r.code = error::invalid_digit;
+			r.position = i + length;
+			return true;
+		}
+		return false;
+	}
+
+	// Only called for a zero value, where all the characters are valid.
+	inline result finish(const char* s, size_t n, result r) {
+		for(size_t i = 0; i < n; i++) {
+			if(s[i] != '_') {
+				return r;
+			}
+		}
+		return result{ 0, error::empty, n };
+	}
+
+
+	template <char B>
+	struct digit {
+		static_assert(B == '0' || B == '1' || B == '\'', "invalid binary digit");
+
+		enum { separator = (B == '\''), value = (B == '1') };
+	};
+
+	template <size_t K>
+	struct words {
+		std::uint64_t values[K];
+	};
+
+	// The digits of a numeric literal of any length, with ' separators. Word
+	// 0 holds the 64 least significant bits, as bit 0 of a std::bitset does.
+	template <char... BB>
+	struct wide {
+		static constexpr size_t count() {
+			constexpr bool separators[] = { bool(digit<BB>::separator)... };
+			size_t result = 0;
+			for(bool separator : separators) {
+				result += !separator;
+			}
+			return result;
+		}
+
+		enum { size = count(), word_count = (size + 63) / 64 };
+
+		static constexpr words<word_count> build() {
+			constexpr bool separators[] = { bool(digit<BB>::separator)... };
+			constexpr bool ones[] = { bool(digit<BB>::value)... };
+			words<word_count> result{};
+			size_t bit = 0;
+			for(size_t i = sizeof...(BB); i > 0; i--) {
+				if(!separators[i - 1]) {
+					result.values[bit / 64] |= std::uint64_t(ones[i - 1]) << (bit % 64);
+					bit++;
+				}
+			}
+			return result;
+		}
+
+		template <size_t... I>
+		static constexpr std::array<std::uint64_t, word_count> array(std::index_sequence<I...>) {
+			return {{ build().values[I]... }};
+		}
+	};
+
+
+namespace radix {
+
+
+	constexpr std::uint64_t ONES = 0x0101010101010101ull;
+	constexpr std::uint64_t HIGH = 0x8080808080808080ull;
+
+	// 0-9, then a-z or A-Z for 10 to 35; 255 for anything else.
+	constexpr unsigned digit(char c) {
+		return (c >= '0' && c <= '9') ? unsigned(c - '0')
+		     : (c >= 'a' && c <= 'z') ? unsigned(c - 'a' + 10)
+		     : (c >= 'A' && c <= 'Z') ? unsigned(c - 'A' + 10)
+		     : 255;
+	}
+
+	constexpr std::uint64_t power(unsigned base, size_t k) {
+		return (k == 0) ? 1 : base * power(base, k - 1);
+	}
+
+	template <unsigned Base>
+	struct powers {
+		static constexpr std::uint64_t values[9] = {
+			power(Base, 0), power(Base, 1), power(Base, 2), power(Base, 3), power(Base, 4),
+			power(Base, 5), power(Base, 6), power(Base, 7), power(Base, 8),
+		};
+	};
+
+	template <unsigned Base>
+	constexpr std::uint64_t powers<Base>::values[9];
+
+	template <unsigned Base>
+	constexpr error scalar(const char* s, size_t n, std::uint64_t& value, size_t& position) {
+		for(size_t i = 0; i < n; i++) {
+			if(s[i] == '_') {
+				continue;
+			}
+			unsigned d = digit(s[i]);
+			if(d >= Base) {
+				position = i;
+				return error::invalid_digit;
+			}
+			std::uint64_t next = 0;
+			if(__builtin_mul_overflow(value, std::uint64_t(Base), &next) || __builtin_add_overflow(next, std::uint64_t(d), &next)) {
+				position = i;
+				return error::overflow;
+			}
+			value = next;
+		}
+		return error::none;
+	}
+
+	// The parse of the string literal operators, which fail to compile in
+	// constant expressions instead of throwing.
+	template <unsigned Base>
+	constexpr std::uint64_t literal(const char* s, size_t n) {
+		std::uint64_t value = 0;
+		size_t position = 0;
+		error code = scalar<Base>(s, n, value, position);
+		if(code == error::invalid_digit) {
+			throw "Not a digit";
+		}
+		if(code == error::overflow) {
+			throw "Too many digits";
+		}
+		for(size_t i = 0; i < n; i++) {
+			if(s[i] != '_') {
+				return value;
+			}
+		}
+		throw "No digits";
+	}
+
+	// High bit of each byte of x between lo and hi, both below 0x80.
+	inline std::uint64_t between(std::uint64_t x, unsigned char lo, unsigned char hi) {
+		std::uint64_t heptets = x & ~HIGH;
+		std::uint64_t at_least_lo = heptets + (0x80 - lo) * ONES;
+		std::uint64_t above_hi = heptets + (0x80 - hi - 1) * ONES;
+		return at_least_lo & ~above_hi & ~x & HIGH;
+	}
+
+	// Setting bit 5 lower-cases letters and leaves digits alone.
+	template <unsigned Base>
+	inline std::uint64_t valid(std::uint64_t x) {
+		if(Base <= 10) {
+			return between(x, '0', '0' + Base - 1);
+		}
+		return between(x, '0', '9') | between(x | (0x20 * ONES), 'a', 'a' + Base - 11);
+	}
+
+	// The value of each byte of x, meaningful for the digits only. No byte
+	// borrows from the next one for digits and separators.
+	template <unsigned Base>
+	inline std::uint64_t values(std::uint64_t x) {
+		if(Base <= 10) {
+			return x - '0' * ONES;
+		}
+		std::uint64_t folded = x | (0x20 * ONES);
+		std::uint64_t letters = between(folded, 'a', 0x7F) >> 7;
+		return folded - '0' * ONES - ('a' - '0' - 10) * letters;
+	}
+
+	// Eight digit values, the first one in the low byte, into their number:
+	// pairs of digits in 16-bit lanes, then 4 digits in 32-bit lanes.
+	template <unsigned Base>
+	inline std::uint64_t combine(std::uint64_t d) {
+		d = (d & 0x00FF00FF00FF00FFull) * Base + ((d >> 8) & 0x00FF00FF00FF00FFull);
+		d = (d & 0x0000FFFF0000FFFFull) * (Base * Base) + ((d >> 16) & 0x0000FFFF0000FFFFull);
+		return (d & 0xFFFFFFFFull) * power(Base, 4) + (d >> 32);
+	}
+
+	// Parses the length characters (at most 8) at s + i as in step() for
+	// binary digits. Separators are squeezed out with pext under BMI2;
+	// without it, words holding separators go through scalar().
+	template <unsigned Base>
+	inline bool step(const char* s, size_t i, size_t length, result& r) {
+		// A short tail fills the low bytes of a zeroed word, gathered from
+		// loads of 4, 2 and 1 bytes that stay within it.
+		std::uint64_t x = 0;
+		if(length == 8) {
+			std::memcpy(&x, s + i, 8);
+		} else {
+			const char* p = s + i;
+			unsigned shift = 0;
+			if(length & 4) {
+				std::uint32_t v;
+				std::memcpy(&v, p, 4);
+				x = v;
+				p += 4;
+				shift = 32;
+			}
+			if(length & 2) {
+				std::uint16_t v;
+				std::memcpy(&v, p, 2);
+				x |= std::uint64_t(v) << shift;
+				p += 2;
+				shift += 16;
+			}
+			if(length & 1) {
+				x |= std::uint64_t(static_cast<unsigned char>(*p)) << shift;
+			}
+		}
+		std::uint64_t bytes = (length == 8) ? HIGH : HIGH & ((std::uint64_t(1) << (8 * length)) - 1);
+		std::uint64_t digits = valid<Base>(x) & bytes;
+		std::uint64_t d = values<Base>(x);
+		size_t count = length;
+		if(digits != bytes) {
+#if defined(__BMI2__)
+			if((digits | (between(x, '_', '_') & bytes)) == bytes) {
+				d = _pext_u64(d, (digits >> 7) * 0xFF);
+				count = __builtin_popcountll(digits);
+			} else
+#endif
+			{
+				r.code = scalar<Base>(s + i, length, r.value, r.position);
+				if(r.code != error::none) {
+					r.position += i;
+					return true;
+				}
+				return false;
+			}
+		}
+		if(count == 0) {
+			return false;
+		}
+		std::uint64_t scaled = 0;
+		std::uint64_t value = 0;
+		if(__builtin_mul_overflow(r.value, powers<Base>::values[count], &scaled)
+		   || __builtin_add_overflow(scaled, combine<Base>(d << (8 * (8 - count))), &value)) {
+			r.code = scalar<Base>(s + i, length, r.value, r.position);
+			r.position += i;
+			return true;
+		}
+		r.value = value;
+		return false;
+	}
+
+
+} /* namespace radix */
+
+
+} /* namespace __impl */
+
+
+// Parses the digits of s as in the _bULL literals: '0' and '1' digits, with
+// any number of '_' separators anywhere. Never throws: invalid characters,
+// values that need more than 64 bits and inputs without any digit are
+// reported with the position of the offending character.
+inline result parse(const char* s, size_t n) {
+	result r{ 0, error::none, size_t(NOT_FOUND) };
+	size_t i = 0;
+#if defined(__AVX2__)
+	const __m256i zero32 = _mm256_set1_epi8('0');
+	const __m256i one32 = _mm256_set1_epi8('1');
+	const __m256i separator32 = _mm256_set1_epi8('_');
+	for(; n - i >= 32; i += 32) {
+		__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+		std::uint32_t ones = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, one32));
+		std::uint32_t digits = ones | std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, zero32)));
+		std::uint32_t separators = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, separator32));
+		if(__impl::step<32>(s, i, 32, ones, digits, ~(digits | separators), r)) {
+			return r;
+		}
+	}
+#endif
+#if defined(__SSE2__)
+	const __m128i zero16 = _mm_set1_epi8('0');
+	const __m128i one16 = _mm_set1_epi8('1');
+	const __m128i separator16 = _mm_set1_epi8('_');
+	for(; n - i >= 16; i += 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+		std::uint32_t ones = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, one16));
+		std::uint32_t digits = ones | std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero16)));
+		std::uint32_t separators = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, separator16));
+		if(__impl::step<16>(s, i, 16, ones, digits, ~(digits | separators) & 0xFFFF, r)) {
+			return r;
+		}
+	}
+	// A short tail is copied into a zeroed chunk, never read past the end;
+	// the lanes past the end are masked out.
+	if(i < n) {
+		std::uint32_t valid = (1u << (n - i)) - 1;
+		alignas(16) char tail[16] = {};
+		std::memcpy(tail, s + i, n - i);
+		__m128i chunk = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+		std::uint32_t ones = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, one16)) & valid;
+		std::uint32_t digits = ones | (std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero16))) & valid);
+		std::uint32_t separators = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, separator16));
+		if(__impl::step<16>(s, i, n - i, ones, digits, ~(digits | separators) & valid, r)) {
+			return r;
+		}
+		return (r.value == 0) ? __impl::finish(s, n, r) : r;
+	}
+#endif
+	r.code = __impl::scalar(s + i, n - i, r.value, r.position);
+	if(r.code != error::none) {
+		r.position += i;
+		return r;
+	}
+	return (r.value == 0) ? __impl::finish(s, n, r) : r;
+}
+
+// The same grammar in any base from 2 to 36: digits, then letters in either
+// case, with '_' separators. Eight characters are converted at once as the
+// bytes of a 64-bit word.
+template <unsigned Base>
+inline result parse(const char* s, size_t n) {
+	static_assert(Base >= 2 && Base <= 36, "bases go from 2 to 36");
+	result r{ 0, error::none, size_t(NOT_FOUND) };
+	size_t i = 0;
+	for(; n - i >= 8; i += 8) {
+		if(__impl::radix::step<Base>(s, i, 8, r)) {
+			return r;
+		}
+	}
+	if(i < n && __impl::radix::step<Base>(s, i, n - i, r)) {
+		return r;
+	}
+	return (r.value == 0) ? __impl::finish(s, n, r) : r;
+}
+
+template <>
+inline result parse<2>(const char* s, size_t n) {
+	return parse(s, n);
+}
+
+
+// The digits of a numeric literal in Base, with ' separators, checked at
+// compile time.
+template <unsigned Base, unsigned long long N, char... CC>
+struct radix_literal {
+	enum : unsigned long long { value = N };
+};
+
+template <unsigned Base, unsigned long long N, char C, char... CC>
+struct radix_literal<Base, N, C, CC...> {
+	static_assert(C == '\'' || __impl::radix::digit(C) < Base, "invalid digit for the base of the literal");
+	static_assert(C == '\'' || N <= (~0ull - __impl::radix::digit(C)) / Base, "literal does not fit in 64 bits");
+
+	enum : unsigned long long {
+		value = radix_literal<Base, (C == '\'') ? N : N * Base + __impl::radix::digit(C), CC...>::value
+	};
+};
+
+
+namespace literals {
+
+
+// 1010'0101_words is a std::array<std::uint64_t, K> of the digits, with
+// 1010'0101_bits the std::bitset<N> of the same digits; N is the number of
+// digits, however many there are. Only the word array is a constant
+// expression, as std::bitset cannot be shifted at compile time.
+template <char... BB>
+constexpr std::array<std::uint64_t, __impl::wide<BB...>::word_count> operator"" _words() {
+	return __impl::wide<BB...>::array(std::make_index_sequence<__impl::wide<BB...>::word_count>());
+}
+
+template <char... BB>
+std::bitset<__impl::wide<BB...>::size> operator"" _bits() {
+	using bitset = std::bitset<__impl::wide<BB...>::size>;
+	constexpr auto words = __impl::wide<BB...>::build();
+	bitset result;
+	for(size_t k = __impl::wide<BB...>::word_count; k > 0; k--) {
+		result = (result << 64) | bitset(words.values[k - 1]);
+	}
+	return result;
+}
+
+// "10xx_01xx"_bx is the pattern of 8-bit words starting with 10 and ending
+// with 01. Numeric literals cannot hold x digits, so this one is a string,
+// evaluated at compile time when used in a constant expression.
+constexpr pattern operator"" _bx(const char* s, size_t n) {
+	pattern result{ 0, 0 };
+	size_t digits = 0;
+	for(size_t i = 0; i < n; i++) {
+		char c = s[i];
+		if(c == '_') {
+			continue;
+		}
+		if(c != '0' && c != '1' && c != 'x') {
+			throw "Not a binary digit";
+		}
+		if(++digits > 64) {
+			throw "Too many binary digits";
+		}
+		result.mask = (result.mask << 1) | (c != 'x');
+		result.value = (result.value << 1) | (c == '1');
+	}
+	return result;
+}
+
+// 0777_o or "dead_beef"_x: numeric literals can only spell the bases up to
+// 10, letters need the string forms.
+template <char... CC>
+constexpr unsigned long long operator"" _o() {
+	return radix_literal<8, 0, CC...>::value;
+}
+
+template <char... CC>
+constexpr unsigned long long operator"" _x() {
+	return radix_literal<16, 0, CC...>::value;
+}
+
+template <char... CC>
+constexpr unsigned long long operator"" _b36() {
+	return radix_literal<36, 0, CC...>::value;
+}
+
+constexpr unsigned long long operator"" _o(const char* s, size_t n) {
+	return __impl::radix::literal<8>(s, n);
+}
+
+constexpr unsigned long long operator"" _x(const char* s, size_t n) {
+	return __impl::radix::literal<16>(s, n);
+}
+
+constexpr unsigned long long operator"" _b36(const char* s, size_t n) {
+	return __impl::radix::literal<36>(s, n);
+}
+
+
+} /* namespace literals */
+
+
+} /* namespace binary_literals */
+
+
+#endif /* BINARY_LITERALS_HPP_ */
@@ -0,0 +1,197 @@
+#ifndef BINARY_LITERALS_BULK_HPP_
+#define BINARY_LITERALS_BULK_HPP_
+
+#include "binary-literals.hpp"
+#include "../static-strings/mapped-file.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace binary_literals {
+
+
+using static_string::mapped_file;
+
+
+// The count of records of a bulk parse, and the first malformed one: its
+// line, counted from 0, and the result of its parse.
+struct bulk_result {
+	size_t records;
+	size_t errors;
+	size_t error_line;
+	result error;
+};
+
+
+namespace __impl {
+namespace bulk {
+
+
+	enum { MIN_CHUNK = 1 << 20, CHUNKS_PER_THREAD = 8 };
+
+	struct chunk {
+		const char* begin;
+		const char* end;
+		size_t first_line;
+		bulk_result summary;
+	};
+
+	// Chunks end right after a newline, so that no record is split.
+	inline std::vector<chunk> split(const char* data, size_t size, unsigned threads) {
+		size_t count = std::max<size_t>(1, std::min<size_t>(size / MIN_CHUNK, size_t(threads) * CHUNKS_PER_THREAD));
+		std::vector<chunk> chunks;
+		const char* begin = data;
+		for(size_t k = 1; k <= count; k++) {
+			const char* end = data + size;
+			if(k < count) {
+				const char* point = std::max(begin, data + size * k / count);
+				const char* newline = static_cast<const char*>(std::memchr(point, '\n', end - point));
+				end = newline ? newline + 1 : end;
+			}
+			if(end > begin || chunks.empty()) {
+				chunks.push_back(chunk{ begin, end, 0, bulk_result{ 0, 0, size_t(NOT_FOUND), result{ 0, error::none, size_t(NOT_FOUND) } } });
+			}
+			begin = end;
+		}
+		return chunks;
+	}
+
+	inline size_t count_lines(const char* begin, const char* end) {
+		size_t lines = 0;
+		for(const char* p = begin; p < end; p++, lines++) {
+			p = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if(p == nullptr) {
+				return lines + 1;
+			}
+		}
+		return lines;
+	}
+
+	// Runs first(k) then second(k) for the count chunks on one set of
+	// workers, the calling thread being one of them. Workers claim chunks
+	// one at a time, and between() runs once all the first calls are done
+	// and before any second one.
+	template <typename First, typename Between, typename Second>
+	void run(unsigned threads, size_t count, First&& first, Between&& between, Second&& second) {
+		std::atomic<size_t> next_first(0);
+		std::atomic<size_t> next_second(0);
+		std::mutex mutex;
+		std::condition_variable done;
+		unsigned arrived = 0;
+		auto worker = [&] {
+			for(size_t k = next_first++; k < count; k = next_first++) {
+				first(k);
+			}
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if(++arrived == threads) {
+					between();
+					done.notify_all();
+				} else {
+					done.wait(lock, [&] { return arrived == threads; });
+				}
+			}
+			for(size_t k = next_second++; k < count; k = next_second++) {
+				second(k);
+			}
+		};
+		std::vector<std::thread> pool;
+		for(unsigned t = 1; t < threads; t++) {
+			pool.emplace_back(worker);
+		}
+		worker();
+		for(std::thread& thread : pool) {
+			thread.join();
+		}
+	}
+
+	template <typename Callback>
+	void parse(chunk& c, Callback& callback) {
+		size_t line = c.first_line;
+		for(const char* p = c.begin; p < c.end; line++) {
+			const char* newline = static_cast<const char*>(std::memchr(p, '\n', c.end - p));
+			const char* end = newline ? newline : c.end;
+			size_t n = end - p;
+			if(n > 0 && p[n - 1] == '\r') {
+				n--;
+			}
+			result r = binary_literals::parse(p, n);
+			if(!r && c.summary.errors++ == 0) {
+				c.summary.error_line = line;
+				c.summary.error = r;
+			}
+			callback(line, r);
+			p = newline ? newline + 1 : c.end;
+		}
+		c.summary.records = line - c.first_line;
+	}
+
+	template <typename Callback>
+	bulk_result for_each(const char* data, size_t size, unsigned threads, Callback& callback) {
+		threads = std::max(1u, threads);
+		std::vector<chunk> chunks = split(data, size, threads);
+		std::vector<size_t> lines(chunks.size());
+		auto measure = [&](size_t k) {
+			lines[k] = count_lines(chunks[k].begin, chunks[k].end);
+		};
+		auto number = [&] {
+			for(size_t k = 1; k < chunks.size(); k++) {
+				chunks[k].first_line = chunks[k - 1].first_line + lines[k - 1];
+			}
+		};
+		run(unsigned(std::min<size_t>(threads, chunks.size())), chunks.size(), measure, number, [&](size_t k) {
+			parse(chunks[k], callback);
+		});
+		bulk_result total = chunks[0].summary;
+		for(size_t k = 1; k < chunks.size(); k++) {
+			total.records += chunks[k].summary.records;
+			if(total.errors == 0) {
+				total.error_line = chunks[k].summary.error_line;
+				total.error = chunks[k].summary.error;
+			}
+			total.errors += chunks[k].summary.errors;
+		}
+		return total;
+	}
+
+
+} /* namespace bulk */
+} /* namespace __impl */
+
+
+// The number of records of a text of one record per line, which is the
+// size of the array to give to parse_records().
+inline size_t count_records(const char* data, size_t size) {
+	return __impl::bulk::count_lines(data, data + size);
+}
+
+// Parses the records of data, one per line as in the _bULL literals with an
+// optional '\r' before the newline, splitting the work between threads.
+// values[line] gets the value of each record, 0 for malformed ones.
+inline bulk_result parse_records(const char* data, size_t size, std::uint64_t* values, unsigned threads) {
+	auto store = [values](size_t line, const result& r) {
+		values[line] = r ? r.value : 0;
+	};
+	return __impl::bulk::for_each(data, size, threads, store);
+}
+
+// Same as above, streaming callback(line, result) for each record instead.
+// Records come in order within a chunk of lines, but the chunks are parsed
+// at the same time on different threads.
+template <typename Callback>
+bulk_result for_each_record(const char* data, size_t size, unsigned threads, Callback&& callback) {
+	return __impl::bulk::for_each(data, size, threads, callback);
+}
+
+
+} /* namespace binary_literals */
+
+
+#endif /* BINARY_LITERALS_BULK_HPP_ */
@@ -0,0 +1,249 @@
+#ifndef BINARY_LITERALS_DECODER_HPP_
+#define BINARY_LITERALS_DECODER_HPP_
+
+#include "binary-literals.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace binary_literals {
+
+
+template <typename Handler>
+struct rule {
+	pattern match;
+	Handler handler;
+};
+
+template <typename Handler>
+constexpr rule<Handler> on(pattern match, Handler handler) {
+	return rule<Handler>{ match, handler };
+}
+
+template <typename Handler, typename... Rules>
+constexpr std::array<rule<Handler>, 1 + sizeof...(Rules)> rules(rule<Handler> first, Rules... others) {
+	return {{ first, others... }};
+}
+
+
+namespace __impl {
+namespace decoder {
+
+
+	// Inner nodes index a table of 2^width children with the bit field of
+	// the word at shift. Leaves hold the rules still possible there, tried
+	// in their original order.
+	enum { MAX_FIELD = 8, LEAF_SIZE = 4 };
+
+	struct node {
+		unsigned shift;
+		unsigned width;
+		std::uint32_t begin;
+		std::uint32_t count;
+	};
+
+	struct field {
+		unsigned shift;
+		unsigned width;
+	};
+
+	struct counter {
+		size_t node_count;
+		size_t slot_count;
+
+		constexpr size_t reserve(size_t slots) {
+			slot_count += slots;
+			return slot_count - slots;
+		}
+
+		constexpr void set(size_t, size_t) {}
+
+		constexpr size_t add(node) {
+			return node_count++;
+		}
+	};
+
+	template <size_t N, size_t Nodes, size_t Slots, typename Rule>
+	struct tables {
+		Rule rules[N];
+		node nodes[Nodes];
+		std::uint32_t slots[Slots];
+		size_t node_count;
+		size_t slot_count;
+
+		constexpr size_t reserve(size_t slots) {
+			slot_count += slots;
+			return slot_count - slots;
+		}
+
+		constexpr void set(size_t slot, size_t value) {
+			slots[slot] = std::uint32_t(value);
+		}
+
+		constexpr size_t add(node n) {
+			nodes[node_count] = n;
+			return node_count++;
+		}
+	};
+
+	// Picks the bit that most of the candidates still test, widened to its
+	// neighbours tested by as many candidates: with opcode-style encodings
+	// this finds whole opcode fields.
+	template <typename Rules>
+	constexpr field choose(const Rules& rules, const size_t* candidates, size_t count, std::uint64_t known) {
+		size_t tested[64] = {};
+		for(size_t k = 0; k < count; k++) {
+			std::uint64_t mask = rules[candidates[k]].match.mask & ~known;
+			for(unsigned b = 0; b < 64; b++) {
+				tested[b] += (mask >> b) & 1;
+			}
+		}
+		unsigned best = 0;
+		for(unsigned b = 1; b < 64; b++) {
+			best = (tested[b] >= tested[best]) ? b : best;
+		}
+		unsigned low = best;
+		unsigned high = best;
+		while(high - low + 1 < MAX_FIELD) {
+			if(high < 63 && tested[high + 1] == tested[best]) {
+				high++;
+			} else if(low > 0 && tested[low - 1] == tested[best]) {
+				low--;
+			} else {
+				break;
+			}
+		}
+		return field{ low, high - low + 1 };
+	}
+
+	template <size_t N, typename Rules, typename Sink>
+	constexpr size_t build(const Rules& rules, const size_t* candidates, size_t count, std::uint64_t known, Sink& sink) {
+		// The first candidate matches every word that gets here once all the
+		// bits it tests are known.
+		if(count > 0 && (rules[candidates[0]].match.mask & ~known) == 0) {
+			count = 1;
+		}
+		if(count <= LEAF_SIZE) {
+			size_t begin = sink.reserve(count);
+			for(size_t k = 0; k < count; k++) {
+				sink.set(begin + k, candidates[k]);
+			}
+			return sink.add(node{ 0, 0, std::uint32_t(begin), std::uint32_t(count) });
+		}
+		field f = choose(rules, candidates, count, known);
+		std::uint64_t bits = ((std::uint64_t(1) << f.width) - 1) << f.shift;
+		size_t begin = sink.reserve(size_t(1) << f.width);
+		size_t id = sink.add(node{ f.shift, f.width, std::uint32_t(begin), 0 });
+		size_t subset[N] = {};
+		for(std::uint64_t j = 0; j < (std::uint64_t(1) << f.width); j++) {
+			size_t n = 0;
+			for(size_t k = 0; k < count; k++) {
+				pattern p = rules[candidates[k]].match;
+				if(((p.value ^ (j << f.shift)) & p.mask & bits) == 0) {
+					subset[n++] = candidates[k];
+				}
+			}
+			sink.set(begin + j, build<N>(rules, subset, n, known | bits, sink));
+		}
+		return id;
+	}
+
+	template <typename Provider>
+	struct generator {
+		using rules_type = decltype(Provider::rules());
+
+		static constexpr rules_type rules = Provider::rules();
+
+		using rule_type = typename std::decay<decltype(rules[0])>::type;
+
+		enum { size = rules.size() };
+
+		template <typename Sink>
+		static constexpr void run(Sink& sink) {
+			size_t all[size] = {};
+			for(size_t k = 0; k < size; k++) {
+				all[k] = k;
+			}
+			build<size>(rules, all, size, 0, sink);
+		}
+
+		static constexpr counter measure() {
+			counter sink{};
+			run(sink);
+			return sink;
+		}
+
+		enum { node_count = measure().node_count, slot_count = measure().slot_count };
+
+		using tables = decoder::tables<size, node_count, slot_count, rule_type>;
+
+		static constexpr tables generate() {
+			tables result{};
+			for(size_t k = 0; k < size; k++) {
+				result.rules[k] = rules[k];
+			}
+			run(result);
+			return result;
+		}
+	};
+
+	template <typename Provider>
+	constexpr typename generator<Provider>::rules_type generator<Provider>::rules;
+
+
+} /* namespace decoder */
+} /* namespace __impl */
+
+
+// Matches words against the rules of Provider::rules(), a constexpr
+// std::array of rules built with rules(on("10xx_01xx"_bx, handler), ...).
+// The first matching rule wins, as in a linear scan of the rules, but
+// finding it only takes a few table lookups: the decision tree is built at
+// compile time.
+template <typename Provider>
+class decoder {
+	using generator = __impl::decoder::generator<Provider>;
+	using tables = typename generator::tables;
+
+	static constexpr tables contents = generator::generate();
+
+public:
+	using rule_type = typename generator::rule_type;
+
+	enum { size = generator::size, node_count = generator::node_count };
+
+	static constexpr const rule_type* rules = contents.rules;
+
+	static const rule_type* find(std::uint64_t word) {
+		const __impl::decoder::node* n = &contents.nodes[0];
+		while(n->width != 0) {
+			n = &contents.nodes[contents.slots[n->begin + ((word >> n->shift) & ((1u << n->width) - 1))]];
+		}
+		for(std::uint32_t k = 0; k < n->count; k++) {
+			const rule_type& r = contents.rules[contents.slots[n->begin + k]];
+			if(r.match.matches(word)) {
+				return &r;
+			}
+		}
+		return nullptr;
+	}
+
+	static size_t index(std::uint64_t word) {
+		const rule_type* r = find(word);
+		return r ? size_t(r - contents.rules) : size_t(NOT_FOUND);
+	}
+};
+
+template <typename Provider>
+constexpr typename decoder<Provider>::tables decoder<Provider>::contents;
+
+template <typename Provider>
+constexpr const typename decoder<Provider>::rule_type* decoder<Provider>::rules;
+
+
+} /* namespace binary_literals */
+
+
+#endif /* BINARY_LITERALS_DECODER_HPP_ */
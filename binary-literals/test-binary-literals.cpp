@@ -0,0 +1,360 @@
+#include "binary-literals.hpp"
+#include "bulk.hpp"
+#include "decoder.hpp"
+#include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+binary_literals::result reference(const std::string& s) {
+	binary_literals::result r{ 0, binary_literals::error::none, binary_literals::NOT_FOUND };
+	bool digits = false;
+	for(size_t i = 0; i < s.size(); i++) {
+		char ch = s[i];
+		if(ch != '0' && ch != '1' && ch != '_') {
+			r.code = binary_literals::error::invalid_digit;
+			r.position = i;
+			return r;
+		}
+		if(ch != '_') {
+			if(r.value >> 63) {
+				r.code = binary_literals::error::overflow;
+				r.position = i;
+				return r;
+			}
+			r.value = (r.value << 1) | (ch - '0');
+			digits = true;
+		}
+	}
+	if(!digits) {
+		r.code = binary_literals::error::empty;
+		r.position = s.size();
+	}
+	return r;
+}
+
+
+template <unsigned Base>
+binary_literals::result reference(const std::string& s) {
+	binary_literals::result r{ 0, binary_literals::error::none, binary_literals::NOT_FOUND };
+	bool digits = false;
+	for(size_t i = 0; i < s.size(); i++) {
+		char ch = s[i];
+		if(ch == '_') {
+			continue;
+		}
+		unsigned d = std::isdigit(ch) ? ch - '0' : std::isalpha(ch) ? std::tolower(ch) - 'a' + 10 : Base;
+		if(d >= Base) {
+			r.code = binary_literals::error::invalid_digit;
+			r.position = i;
+			return r;
+		}
+		if(r.value > (~0ull - d) / Base) {
+			r.code = binary_literals::error::overflow;
+			r.position = i;
+			return r;
+		}
+		r.value = r.value * Base + d;
+		digits = true;
+	}
+	if(!digits) {
+		r.code = binary_literals::error::empty;
+		r.position = s.size();
+	}
+	return r;
+}
+
+
+void testParse() {
+	using binary_literals::error;
+	using binary_literals::parse;
+
+	assert(parse("0", 1).value == 0 && parse("0", 1));
+	assert(parse("1101_0100__0011_0001", 20).value == 0xD431);
+	assert(parse("1111111111111111111111111111111111111111111111111111111111111111", 64).value == ~0ull);
+	assert(parse("0_0000000000000000000000000000000000000000000000000000000000000000001", 69).value == 1);
+	assert(parse("1101", 4).position == binary_literals::NOT_FOUND);
+
+	assert(parse("", 0).code == error::empty);
+	assert(parse("", 0).position == 0);
+	assert(parse("__", 2).code == error::empty);
+	assert(parse("__", 2).position == 2);
+
+	assert(parse("0101_0102", 9).code == error::invalid_digit);
+	assert(parse("0101_0102", 9).position == 8);
+	assert(parse("0101_0102", 9).value == 0x2A);
+	assert(!parse("0000000000000000000000000000000000000000 1", 42));
+	assert(parse("0000000000000000000000000000000000000000 1", 42).position == 40);
+	assert(parse("_x", 2).code == error::invalid_digit);
+
+	binary_literals::result r = parse("1_0000000000000000000000000000000000000000000000000000000000000001", 66);
+	assert(r.code == error::overflow);
+	assert(r.position == 65);
+	assert(r.value == 1ull << 63);
+	r = parse("11111111111111111111111111111111111111111111111111111111111111111x", 66);
+	assert(r.code == error::overflow);
+	assert(r.position == 64);
+}
+
+
+void testParseAgainstReference() {
+	std::mt19937 random(42);
+	const char alphabet[] = "0101010101_";
+	for(int round = 0; round < 100000; round++) {
+		std::string s;
+		size_t n = random() % 150;
+		for(size_t i = 0; i < n; i++) {
+			s += alphabet[random() % (sizeof(alphabet) - 1)];
+		}
+		if(n > 0 && random() % 2 == 0) {
+			size_t zeros = random() % n;
+			for(size_t i = 0; i < zeros; i++) {
+				if(s[i] == '1') {
+					s[i] = '0';
+				}
+			}
+		}
+		if(n > 0 && random() % 4 == 0) {
+			s[random() % n] = "2a/ \xFF"[random() % 5];
+		}
+		binary_literals::result expected = reference(s);
+		binary_literals::result r = binary_literals::parse(s.data(), s.size());
+		assert(r.code == expected.code);
+		assert(r.position == expected.position);
+		assert(r.value == expected.value);
+	}
+}
+
+
+void testWideLiterals() {
+	using namespace binary_literals::literals;
+
+	constexpr auto small = 1010'0101_words;
+	static_assert(small.size() == 1 && small[0] == 0xA5, "");
+	constexpr auto lane = 1'0000000000000000000000000000000000000000000000000000000000000000'0000000000000000000000000000000000000000000000000000000000000011_words;
+	static_assert(lane.size() == 3 && lane[0] == 3 && lane[1] == 0 && lane[2] == 1, "");
+	static_assert((1111111111111111111111111111111111111111111111111111111111111111_words).size() == 1, "");
+	static_assert((01111111111111111111111111111111111111111111111111111111111111111_words).size() == 2, "");
+
+	assert((1010'0101_bits).size() == 8);
+	assert((1010'0101_bits).to_ulong() == 0xA5);
+	assert((0001_bits).size() == 4);
+	auto mask = 1'0000000000000000000000000000000000000000000000000000000000000000'0000000000000000000000000000000000000000000000000000000000000011_bits;
+	assert(mask.size() == 129);
+	assert(mask.count() == 3 && mask[0] && mask[1] && mask[128]);
+	assert(mask.to_string() == "1" + std::string(126, '0') + "11");
+
+	// 1012_words; // SHOULD NOT COMPILE!
+	// 0x1F_bits; // SHOULD NOT COMPILE!
+}
+
+
+template <unsigned Base>
+void testRadixAgainstReference(size_t maximum) {
+	std::mt19937 random(Base);
+	const char alphabet[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+	size_t letters = (Base <= 10) ? Base : 10 + 2 * (Base - 10);
+	for(int round = 0; round < 20000; round++) {
+		std::string s;
+		size_t n = random() % maximum;
+		for(size_t i = 0; i < n; i++) {
+			size_t k = random() % letters;
+			s += (random() % 8 == 0) ? '_' : alphabet[(k < 10 || k < Base) ? k : 36 + (k - Base)];
+		}
+		if(n > 0 && random() % 4 == 0) {
+			s[random() % n] = "0a/ \xFF_zZ:@`{"[random() % 12];
+		}
+		binary_literals::result expected = reference<Base>(s);
+		binary_literals::result r = binary_literals::parse<Base>(s.data(), s.size());
+		assert(r.code == expected.code);
+		assert(r.position == expected.position);
+		assert(r.value == expected.value);
+	}
+}
+
+void testRadix() {
+	using namespace binary_literals::literals;
+	using binary_literals::error;
+	using binary_literals::parse;
+
+	static_assert(0777_o == 511 && 1'000_o == 512, "");
+	static_assert(1000_x == 0x1000 && 10_b36 == 36, "");
+	static_assert("dead_BEEF"_x == 0xDEADBEEF && "ffff_ffff_ffff_ffff"_x == ~0ull, "");
+	static_assert("1_777"_o == 01777 && "zz"_b36 == 36 * 36 - 1, "");
+	static_assert(binary_literals::radix_literal<10, 0, '1', '8', '4', '4', '6', '7', '4', '4', '0', '7', '3', '7', '0', '9', '5', '5', '1', '6', '1', '5'>::value == ~0ull, "");
+	// 778_o; // SHOULD NOT COMPILE!
+	// 0x1F_x; // SHOULD NOT COMPILE!
+	// 2000000000000000000000_o; // SHOULD NOT COMPILE!
+	// constexpr auto a = "1_0000_0000_0000_0000"_x; // SHOULD NOT COMPILE!
+	// constexpr auto b = "___"_x; // SHOULD NOT COMPILE!
+
+	assert(parse<16>("DeadBeef_0123_4567", 18).value == 0xDEADBEEF01234567);
+	assert(parse<16>("DeadBeef_0123_4567", 18).position == binary_literals::NOT_FOUND);
+	assert(parse<10>("18446744073709551615", 20).value == ~0ull);
+	assert(parse<10>("18446744073709551616", 20).code == error::overflow);
+	assert(parse<10>("18446744073709551616", 20).position == 19);
+	assert(parse<10>("18446744073709551616", 20).value == 1844674407370955161);
+	assert(parse<8>("1238", 4).code == error::invalid_digit);
+	assert(parse<8>("1238", 4).position == 3);
+	assert(parse<36>("", 0).code == error::empty);
+	assert(parse<36>("________", 8).code == error::empty);
+	assert(parse<36>("________0", 9).value == 0 && parse<36>("________0", 9));
+	assert(parse<2>("1_0", 3).value == 2);
+
+	testRadixAgainstReference<8>(40);
+	testRadixAgainstReference<10>(40);
+	testRadixAgainstReference<16>(40);
+	testRadixAgainstReference<36>(40);
+	testRadixAgainstReference<7>(40);
+}
+
+
+void testBulk() {
+	std::mt19937 random(1);
+	std::string text;
+	std::vector<binary_literals::result> expected;
+	for(int line = 0; line < 100000; line++) {
+		std::string record;
+		size_t n = random() % 70;
+		for(size_t i = 0; i < n; i++) {
+			record += "0101010101_"[random() % 11];
+		}
+		if(n > 0 && random() % 16 == 0) {
+			record[random() % n] = 'z';
+		}
+		expected.push_back(reference(record));
+		text += record + (random() % 8 == 0 ? "\r\n" : "\n");
+	}
+	text += "1011";
+	expected.push_back(reference("1011"));
+
+	for(unsigned threads : { 1, 3 }) {
+		assert(binary_literals::count_records(text.data(), text.size()) == expected.size());
+		std::vector<std::uint64_t> values(expected.size(), 42);
+		binary_literals::bulk_result summary = binary_literals::parse_records(text.data(), text.size(), values.data(), threads);
+		assert(summary.records == expected.size());
+		size_t errors = 0;
+		size_t first = binary_literals::NOT_FOUND;
+		for(size_t line = 0; line < expected.size(); line++) {
+			assert(values[line] == (expected[line] ? expected[line].value : 0));
+			if(!expected[line] && errors++ == 0) {
+				first = line;
+			}
+		}
+		assert(summary.errors == errors);
+		assert(summary.error_line == first);
+		assert(summary.error.code == expected[first].code && summary.error.position == expected[first].position);
+
+		std::vector<binary_literals::result> results(expected.size());
+		binary_literals::for_each_record(text.data(), text.size(), threads, [&](size_t line, const binary_literals::result& r) {
+			results[line] = r;
+		});
+		for(size_t line = 0; line < expected.size(); line++) {
+			assert(results[line].code == expected[line].code && results[line].value == expected[line].value);
+		}
+	}
+
+	const char* path = "test-binary-literals.records";
+	std::ofstream(path, std::ios::binary) << "1_0\n\n11\r\n";
+	{
+		binary_literals::mapped_file file(path);
+		std::uint64_t values[3];
+		binary_literals::bulk_result summary = binary_literals::parse_records(file.data(), file.size(), values, 2);
+		assert(summary.records == 3 && summary.errors == 1 && summary.error_line == 1);
+		assert(summary.error.code == binary_literals::error::empty);
+		assert(values[0] == 2 && values[1] == 0 && values[2] == 3);
+	}
+	std::ofstream(path, std::ios::binary).close();
+	{
+		binary_literals::mapped_file file(path);
+		assert(file.size() == 0 && binary_literals::count_records(file.data(), file.size()) == 0);
+		assert(binary_literals::parse_records(file.data(), file.size(), nullptr, 4).records == 0);
+	}
+	std::remove(path);
+
+	bool thrown = false;
+	try {
+		binary_literals::mapped_file file(path);
+	} catch(const std::system_error&) {
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+
+int nop(std::uint64_t) { return 0; }
+int load(std::uint64_t w) { return 100 + int(w & 3); }
+int store(std::uint64_t w) { return 200 + int(w & 3); }
+int jump(std::uint64_t w) { return 300 + int(w & 0xF); }
+int halt(std::uint64_t) { return 400; }
+
+struct ToyIsa {
+	static constexpr auto rules() {
+		using namespace binary_literals::literals;
+		using binary_literals::on;
+		return binary_literals::rules(
+			on("0000_0000"_bx, &nop),
+			on("0001_xx00"_bx, &load),
+			on("0001_xx01"_bx, &store),
+			on("0001_1101"_bx, &halt), // Never chosen: store wins.
+			on("0001_1111"_bx, &halt),
+			on("01xx_xxxx"_bx, &jump),
+			on("0x10_xxxx"_bx, &store),
+			on("1111_1111"_bx, &halt),
+			on("1xxx_0000"_bx, &load),
+			on("1xxx_xx01"_bx, &nop),
+			on("xxxx_xx10"_bx, &jump)
+		);
+	}
+};
+
+void testDecoder() {
+	using namespace binary_literals::literals;
+
+	constexpr binary_literals::pattern p = "10xx_01xx"_bx;
+	static_assert(p.mask == 0xCC && p.value == 0x84, "");
+	static_assert(p.matches(0xB7) && !p.matches(0xBB), "");
+	static_assert("x"_bx.mask == 0 && "1111111111111111111111111111111111111111111111111111111111111111"_bx.value == ~0ull, "");
+	// constexpr auto q = "10y"_bx; // SHOULD NOT COMPILE!
+	bool thrown = false;
+	try {
+		std::string s = "10y";
+		binary_literals::literals::operator"" _bx(s.data(), s.size());
+	} catch(const char*) {
+		thrown = true;
+	}
+	assert(thrown);
+
+	using decoder = binary_literals::decoder<ToyIsa>;
+	for(std::uint64_t w = 0; w < 256; w++) {
+		size_t expected = binary_literals::NOT_FOUND;
+		for(size_t k = 0; k < decoder::size; k++) {
+			if(decoder::rules[k].match.matches(w)) {
+				expected = k;
+				break;
+			}
+		}
+		assert(decoder::index(w) == expected);
+		const decoder::rule_type* r = decoder::find(w);
+		assert(r ? r->handler(w) == decoder::rules[expected].handler(w) : expected == binary_literals::NOT_FOUND);
+	}
+	assert(decoder::find(0x1C)->handler(0x1C) == 100);
+	assert(decoder::find(0x1D)->handler(0x1D) == 201);
+	assert(decoder::find(0x1F)->handler(0x1F) == 400);
+	assert(decoder::find(0x03) == nullptr);
+}
+
+
+int main() {
+	testParse();
+	testParseAgainstReference();
+	testWideLiterals();
+	testDecoder();
+	testRadix();
+	testBulk();
+}
@@ -0,0 +1,218 @@
+#ifndef STATIC_LITERALS_HPP_
+#define STATIC_LITERALS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+
+namespace static_literals {
+
+
+class literal;
+class interned;
+
+namespace literals {
+
+constexpr literal operator"" _s(const char* s, size_t n);
+
+} /* namespace literals */
+
+
+// A string literal with its length, embedded NULs included. Only the _s
+// operator makes them, so they always point to static storage and can be
+// passed around by value and kept forever without copying the characters.
+class literal {
+public:
+	constexpr literal() : chars(""), count(0) {}
+
+	constexpr const char* data() const {
+		return chars;
+	}
+
+	constexpr size_t size() const {
+		return count;
+	}
+
+	constexpr size_t length() const {
+		return count;
+	}
+
+	constexpr bool empty() const {
+		return count == 0;
+	}
+
+	constexpr const char* begin() const {
+		return chars;
+	}
+
+	constexpr const char* end() const {
+		return chars + count;
+	}
+
+	constexpr char operator[](size_t i) const {
+		return chars[i];
+	}
+
+	std::string string() const {
+		return std::string(chars, count);
+	}
+
+	interned intern() const;
+
+private:
+	constexpr literal(const char* data, size_t size) : chars(data), count(size) {}
+
+	friend constexpr literal literals::operator"" _s(const char* s, size_t n);
+
+	const char* chars;
+	size_t count;
+};
+
+constexpr bool operator==(literal a, literal b) {
+	if(a.size() != b.size()) {
+		return false;
+	}
+	for(size_t i = 0; i < a.size(); i++) {
+		if(a[i] != b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+constexpr bool operator!=(literal a, literal b) {
+	return !(a == b);
+}
+
+inline std::ostream& operator<<(std::ostream& out, literal s) {
+	return out.write(s.data(), s.size());
+}
+
+
+namespace __impl {
+
+
+	// A fixed open-addressing table, so that interning never allocates. A
+	// slot is claimed with a CAS, then published once its entry is written.
+	enum { CAPACITY = 1 << 12 };
+	enum : unsigned char { EMPTY, CLAIMED, READY };
+
+	struct table {
+		std::atomic<unsigned char> states[CAPACITY];
+		literal entries[CAPACITY];
+	};
+
+	inline table& instance() {
+		static table t;
+		return t;
+	}
+
+	inline std::uint64_t hash(const char* s, size_t n) {
+		std::uint64_t h = 0xCBF29CE484222325ull;
+		for(size_t i = 0; i < n; i++) {
+			h = (h ^ static_cast<unsigned char>(s[i])) * 0x100000001B3ull;
+		}
+		return h;
+	}
+
+	inline const literal* intern(literal s) {
+		table& t = instance();
+		std::uint64_t h = hash(s.data(), s.size());
+		for(size_t probe = 0; probe < CAPACITY; probe++) {
+			size_t slot = (h + probe) & (CAPACITY - 1);
+			unsigned char state = t.states[slot].load(std::memory_order_acquire);
+			if(state == EMPTY && t.states[slot].compare_exchange_strong(state, CLAIMED, std::memory_order_acquire)) {
+				t.entries[slot] = s;
+				t.states[slot].store(READY, std::memory_order_release);
+				return &t.entries[slot];
+			}
+			while(state == CLAIMED) {
+				state = t.states[slot].load(std::memory_order_acquire);
+			}
+			if(t.entries[slot] == s) {
+				return &t.entries[slot];
+			}
+		}
+		throw std::length_error("too many interned string literals");
+	}
+
+
+} /* namespace __impl */
+
+
+// The one entry of the intern table for the characters of a literal: equal
+// strings get equal handles, compared and hashed as pointers.
+class interned {
+public:
+	const char* data() const {
+		return entry->data();
+	}
+
+	size_t size() const {
+		return entry->size();
+	}
+
+	literal value() const {
+		return *entry;
+	}
+
+	size_t hash() const {
+		return std::hash<const literal*>()(entry);
+	}
+
+	friend bool operator==(interned a, interned b) {
+		return a.entry == b.entry;
+	}
+
+	friend bool operator!=(interned a, interned b) {
+		return a.entry != b.entry;
+	}
+
+private:
+	explicit interned(const literal* e) : entry(e) {}
+
+	friend class literal;
+
+	const literal* entry;
+};
+
+inline interned literal::intern() const {
+	return interned(__impl::intern(*this));
+}
+
+inline std::ostream& operator<<(std::ostream& out, interned s) {
+	return out << s.value();
+}
+
+
+namespace literals {
+
+// "abc\0def"_s.length() == 7, with no copy of the characters.
+constexpr literal operator"" _s(const char* s, size_t n) {
+	return literal(s, n);
+}
+
+} /* namespace literals */
+
+
+} /* namespace static_literals */
+
+
+namespace std {
+
+template <>
+struct hash<static_literals::interned> {
+	size_t operator()(static_literals::interned s) const {
+		return s.hash();
+	}
+};
+
+} /* namespace std */
+
+
+#endif /* STATIC_LITERALS_HPP_ */
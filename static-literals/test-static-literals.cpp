@@ -0,0 +1,119 @@
+#include "static-literals.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+size_t allocations = 0;
+
+void* operator new(size_t size) {
+	allocations++;
+	if(void* p = std::malloc(size ? size : 1)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	std::free(p);
+}
+
+
+using namespace static_literals::literals;
+
+
+void testLiteral() {
+	constexpr static_literals::literal s = "abc\0def"_s;
+	static_assert(s.length() == 7 && s[3] == '\0' && s[6] == 'f', "");
+	static_assert("abc"_s == "abc"_s && "abc"_s != "abd"_s && "abc"_s != "abc\0"_s, "");
+	static_assert(static_literals::literal().empty(), "");
+	assert(s.string() == std::string("abc\0def", 7));
+	assert(std::string(s.begin(), s.end()).size() == 7);
+
+	std::ostringstream out;
+	out << "x\0y"_s;
+	assert(out.str() == std::string("x\0y", 3));
+}
+
+
+void testIntern() {
+	static_literals::interned a = "alpha"_s.intern();
+	static_literals::interned b = "alpha"_s.intern();
+	static_literals::interned c = "alpha\0"_s.intern();
+	assert(a == b && a.data() == b.data());
+	assert(a != c && c.size() == 6);
+	assert(a.value() == "alpha"_s);
+	assert(std::hash<static_literals::interned>()(a) == std::hash<static_literals::interned>()(b));
+
+	const static_literals::literal keys[] = {
+		"zero"_s, "one"_s, "two"_s, "three"_s, "four"_s, "five"_s, "six"_s, "seven"_s,
+		"eight"_s, "nine"_s, "ten"_s, "eleven"_s, "twelve"_s, "thirteen"_s, "fourteen"_s, "fifteen"_s,
+	};
+	const size_t count = sizeof(keys) / sizeof(keys[0]);
+	std::vector<std::vector<const char*>> seen(8, std::vector<const char*>(count));
+	std::vector<std::thread> threads;
+	for(size_t t = 0; t < seen.size(); t++) {
+		threads.emplace_back([&, t] {
+			for(int round = 0; round < 1000; round++) {
+				for(size_t k = 0; k < count; k++) {
+					size_t key = (k * 7 + t + round) % count;
+					seen[t][key] = keys[key].intern().data();
+				}
+			}
+		});
+	}
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+	for(size_t k = 0; k < count; k++) {
+		assert(seen[0][k] == keys[k].intern().data());
+		for(size_t t = 1; t < seen.size(); t++) {
+			assert(seen[t][k] == seen[0][k]);
+		}
+	}
+}
+
+
+void testNoAllocations() {
+	std::unordered_map<static_literals::interned, int> counts;
+	counts.reserve(16);
+	counts["get"_s.intern()] = 0;
+	counts["put"_s.intern()] = 0;
+
+	allocations = 0;
+	size_t total = 0;
+	for(int i = 0; i < 10000; i++) {
+		static_literals::literal method = (i % 3 == 0) ? "put: a key long enough not to fit any small buffer"_s : "get"_s;
+		total += method.length();
+		static_literals::interned key = (i % 3 == 0) ? "put"_s.intern() : "get"_s.intern();
+		counts[key]++;
+		total += (key == "get"_s.intern());
+		total += "abc\0def"_s.length();
+	}
+	assert(allocations == 0);
+	assert(total > 0 && counts["get"_s.intern()] == 6666 && counts["put"_s.intern()] == 3334);
+
+	// What the std::string-returning _s did for long literals.
+	allocations = 0;
+	for(int i = 0; i < 100; i++) {
+		std::string s("put: a key long enough not to fit any small buffer");
+		total += s.length();
+	}
+	assert(allocations == 100);
+}
+
+
+int main() {
+	testLiteral();
+	testIntern();
+	testNoAllocations();
+}
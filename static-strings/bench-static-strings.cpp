@@ -0,0 +1,825 @@
+#include "static-strings.hpp"
+#include "compress.hpp"
+#include "csv.hpp"
+#include "digest.hpp"
+#include "enums.hpp"
+#include "format.hpp"
+#include "icase.hpp"
+#include "lookup.hpp"
+#include "pool.hpp"
+#include "regex.hpp"
+#include "searcher.hpp"
+#include "trie.hpp"
+#include "utf.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <experimental/functional>
+#include <codecvt>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <random>
+#include <regex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <strings.h>
+
+
+template <typename F>
+double elapsed(F&& f, size_t& checksum) {
+	auto start = std::chrono::steady_clock::now();
+	checksum = f();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+template <typename F>
+void measure(const char* name, size_t count, F&& f) {
+	size_t checksum;
+	double ns = elapsed(f, checksum);
+	std::printf("  %-40s %10.2f ns/op  (checksum %zu)\n", name, ns / count, checksum);
+}
+
+template <typename F>
+void throughput(const char* name, size_t bytes, F&& f) {
+	size_t checksum;
+	double ns = elapsed(f, checksum);
+	std::printf("  %-40s %10.2f GB/s   (checksum %zu)\n", name, bytes / ns, checksum);
+}
+
+
+#define KEYWORD(NAME, STR) \
+	struct NAME { constexpr static const char* str() { return STR; } }
+
+namespace keywords {
+	KEYWORD(Auto,     "auto");
+	KEYWORD(Break,    "break");
+	KEYWORD(Case,     "case");
+	KEYWORD(Char,     "char");
+	KEYWORD(Const,    "const");
+	KEYWORD(Continue, "continue");
+	KEYWORD(Default,  "default");
+	KEYWORD(Do,       "do");
+	KEYWORD(Double,   "double");
+	KEYWORD(Else,     "else");
+	KEYWORD(Enum,     "enum");
+	KEYWORD(For,      "for");
+	KEYWORD(If,       "if");
+	KEYWORD(Int,      "int");
+	KEYWORD(Return,   "return");
+	KEYWORD(Struct,   "struct");
+}
+
+void benchTrie() {
+	using namespace keywords;
+	using Keywords = static_string::trie<
+		static_string::from_provider<Auto>,   static_string::from_provider<Break>,
+		static_string::from_provider<Case>,   static_string::from_provider<Char>,
+		static_string::from_provider<Const>,  static_string::from_provider<Continue>,
+		static_string::from_provider<Default>,static_string::from_provider<Do>,
+		static_string::from_provider<Double>, static_string::from_provider<Else>,
+		static_string::from_provider<Enum>,   static_string::from_provider<For>,
+		static_string::from_provider<If>,     static_string::from_provider<Int>,
+		static_string::from_provider<Return>, static_string::from_provider<Struct>>;
+
+	const std::vector<std::string> names = {
+		"auto", "break", "case", "char", "const", "continue", "default", "do",
+		"double", "else", "enum", "for", "if", "int", "return", "struct",
+	};
+	const std::vector<std::string> others = {
+		"value", "i", "index", "integer", "constant", "dot", "forward", "result",
+	};
+
+	std::map<std::string, size_t> map;
+	std::unordered_map<std::string, size_t> hash;
+	for(size_t i = 0; i < names.size(); i++) {
+		map[names[i]] = i;
+		hash[names[i]] = i;
+	}
+
+	std::mt19937 random(42);
+	std::vector<std::string> inputs;
+	for(size_t i = 0; i < 1000000; i++) {
+		const std::vector<std::string>& from = (random() % 4 == 0) ? others : names;
+		inputs.push_back(from[random() % from.size()]);
+	}
+
+	std::printf("trie (%zu keys, %zu lookups)\n", names.size(), inputs.size());
+	measure("static_string::trie", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			sum += Keywords::match(s.data(), s.size()).index + 1;
+		}
+		return sum;
+	});
+	measure("std::map", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			auto it = map.find(s);
+			sum += (it == map.end() ? static_string::NOT_FOUND : it->second) + 1;
+		}
+		return sum;
+	});
+	measure("std::unordered_map", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			auto it = hash.find(s);
+			sum += (it == hash.end() ? static_string::NOT_FOUND : it->second) + 1;
+		}
+		return sum;
+	});
+}
+
+
+void benchLookup() {
+	using namespace keywords;
+	using Table = static_string::lookup_table<
+		static_string::entry<static_string::from_provider<Auto>,     size_t,  0>,
+		static_string::entry<static_string::from_provider<Break>,    size_t,  1>,
+		static_string::entry<static_string::from_provider<Case>,     size_t,  2>,
+		static_string::entry<static_string::from_provider<Char>,     size_t,  3>,
+		static_string::entry<static_string::from_provider<Const>,    size_t,  4>,
+		static_string::entry<static_string::from_provider<Continue>, size_t,  5>,
+		static_string::entry<static_string::from_provider<Default>,  size_t,  6>,
+		static_string::entry<static_string::from_provider<Do>,       size_t,  7>,
+		static_string::entry<static_string::from_provider<Double>,   size_t,  8>,
+		static_string::entry<static_string::from_provider<Else>,     size_t,  9>,
+		static_string::entry<static_string::from_provider<Enum>,     size_t, 10>,
+		static_string::entry<static_string::from_provider<For>,      size_t, 11>,
+		static_string::entry<static_string::from_provider<If>,       size_t, 12>,
+		static_string::entry<static_string::from_provider<Int>,      size_t, 13>,
+		static_string::entry<static_string::from_provider<Return>,   size_t, 14>,
+		static_string::entry<static_string::from_provider<Struct>,   size_t, 15>>;
+
+	const std::vector<std::string> names = {
+		"struct", "return", "int", "if", "for", "enum", "else", "double",
+		"do", "default", "continue", "const", "char", "case", "break", "auto",
+	};
+	const std::vector<std::string> others = {
+		"value", "i", "index", "integer", "constant", "dot", "forward", "result",
+	};
+
+	std::mt19937 random(42);
+	std::vector<std::string> inputs;
+	for(size_t i = 0; i < 1000000; i++) {
+		const std::vector<std::string>& from = (random() % 4 == 0) ? others : names;
+		inputs.push_back(from[random() % from.size()]);
+	}
+
+	std::printf("sorted lookup (%zu keys, %zu lookups)\n", names.size(), inputs.size());
+	measure("std::sort (startup)", names.size(), [&] {
+		std::vector<std::pair<std::string, size_t>> table;
+		for(size_t i = 0; i < names.size(); i++) {
+			table.emplace_back(names[i], 15 - i);
+		}
+		std::sort(table.begin(), table.end());
+		return table.size();
+	});
+	std::vector<std::pair<std::string, size_t>> table;
+	for(size_t i = 0; i < names.size(); i++) {
+		table.emplace_back(names[i], 15 - i);
+	}
+	std::sort(table.begin(), table.end());
+
+	measure("static_string::lookup_table", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			const size_t* value = Table::find(s);
+			sum += (value == nullptr ? static_string::NOT_FOUND : *value) + 1;
+		}
+		return sum;
+	});
+	measure("std::lower_bound", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			auto it = std::lower_bound(table.begin(), table.end(), s, [](const std::pair<std::string, size_t>& e, const std::string& k) {
+				return e.first < k;
+			});
+			sum += (it == table.end() || it->first != s ? static_string::NOT_FOUND : it->second) + 1;
+		}
+		return sum;
+	});
+}
+
+
+namespace levels {
+	enum class level { trace, debug, info, notice, warning, error, critical, alert, emergency };
+	KEYWORD(Trace,     "trace");
+	KEYWORD(Debug,     "debug");
+	KEYWORD(Info,      "info");
+	KEYWORD(Notice,    "notice");
+	KEYWORD(Warning,   "warning");
+	KEYWORD(Error,     "error");
+	KEYWORD(Critical,  "critical");
+	KEYWORD(Alert,     "alert");
+	KEYWORD(Emergency, "emergency");
+}
+
+void benchEnumNames() {
+	using namespace levels;
+	using Levels = static_string::enum_names<level,
+		static_string::enumerator<level, level::trace,     static_string::from_provider<Trace>>,
+		static_string::enumerator<level, level::debug,     static_string::from_provider<Debug>>,
+		static_string::enumerator<level, level::info,      static_string::from_provider<Info>>,
+		static_string::enumerator<level, level::notice,    static_string::from_provider<Notice>>,
+		static_string::enumerator<level, level::warning,   static_string::from_provider<Warning>>,
+		static_string::enumerator<level, level::error,     static_string::from_provider<Error>>,
+		static_string::enumerator<level, level::critical,  static_string::from_provider<Critical>>,
+		static_string::enumerator<level, level::alert,     static_string::from_provider<Alert>>,
+		static_string::enumerator<level, level::emergency, static_string::from_provider<Emergency>>>;
+
+	std::map<level, std::string> names;
+	std::map<std::string, level> values;
+	for(size_t i = 0; i < Levels::size; i++) {
+		names[Levels::values[i]] = Levels::name(Levels::values[i]).string();
+		values[Levels::name(Levels::values[i]).string()] = Levels::values[i];
+	}
+
+	std::mt19937 random(42);
+	std::vector<level> levels;
+	std::vector<std::string> inputs;
+	for(size_t i = 0; i < 1000000; i++) {
+		levels.push_back(level(random() % Levels::size));
+		inputs.push_back(names[levels.back()]);
+	}
+
+	std::printf("enum names (%d enumerators, %zu conversions)\n", Levels::size, levels.size());
+	measure("static_string::enum_names::name", levels.size(), [&] {
+		size_t sum = 0;
+		for(level l : levels) {
+			sum += Levels::name(l).size;
+		}
+		return sum;
+	});
+	measure("std::map<enum, std::string>", levels.size(), [&] {
+		size_t sum = 0;
+		for(level l : levels) {
+			sum += names.find(l)->second.size();
+		}
+		return sum;
+	});
+	measure("static_string::enum_names::parse", inputs.size(), [&] {
+		size_t sum = 0;
+		level l = level::trace;
+		for(const std::string& s : inputs) {
+			sum += Levels::parse(s, l) ? size_t(l) : 0;
+		}
+		return sum;
+	});
+	measure("std::map<std::string, enum>", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			auto it = values.find(s);
+			sum += (it != values.end()) ? size_t(it->second) : 0;
+		}
+		return sum;
+	});
+}
+
+
+void benchCaseInsensitive() {
+	struct ContentSecurityPolicy { constexpr static const char* str() { return "Content-Security-Policy-Report-Only"; } };
+	using Key = static_string::from_provider<ContentSecurityPolicy>;
+
+	const std::vector<std::string> headers = {
+		"Content-Security-Policy-Report-Only", "Content-Security-Policy", "Strict-Transport-Security",
+		"Access-Control-Allow-Credentials", "Cross-Origin-Embedder-Policy", "X-Content-Type-Options",
+	};
+	std::mt19937 random(42);
+	std::vector<std::string> inputs;
+	size_t bytes = 0;
+	for(size_t i = 0; i < 1000000; i++) {
+		std::string s = headers[random() % headers.size()];
+		for(char& c : s) {
+			c = (random() % 2 == 0) ? std::toupper(c) : std::tolower(c);
+		}
+		bytes += s.size();
+		inputs.push_back(s);
+	}
+
+	std::printf("case-insensitive matching (%zu inputs)\n", inputs.size());
+	measure("static_string::icase::equal<Key>", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			sum += static_string::icase::equal<Key>(s);
+		}
+		return sum;
+	});
+	measure("strncasecmp", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			sum += s.size() == size_t(Key::size) && ::strncasecmp(s.data(), Key::data, Key::size) == 0;
+		}
+		return sum;
+	});
+	measure("lower-cased copy + operator==", inputs.size(), [&] {
+		size_t sum = 0;
+		const std::string key = static_string::to_lower<Key>::string();
+		for(const std::string& s : inputs) {
+			std::string lower(s);
+			for(char& c : lower) {
+				c = std::tolower(c);
+			}
+			sum += lower == key;
+		}
+		return sum;
+	});
+	measure("static_string::icase::hash", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			sum += static_string::icase::hash(s) == static_string::icase::hash_of<Key>::value;
+		}
+		return sum;
+	});
+	measure("lower-cased copy + std::hash", inputs.size(), [&] {
+		size_t sum = 0;
+		const size_t key = std::hash<std::string>()(static_string::to_lower<Key>::string());
+		for(const std::string& s : inputs) {
+			std::string lower(s);
+			for(char& c : lower) {
+				c = std::tolower(c);
+			}
+			sum += std::hash<std::string>()(lower) == key;
+		}
+		return sum;
+	});
+}
+
+
+std::string makeLog(size_t bytes) {
+	const char* levels[] = { "INFO", "DEBUG", "WARN", "TRACE" };
+	std::mt19937 random(42);
+	std::string log;
+	log.reserve(bytes + 256);
+	char line[256];
+	for(size_t n = 0; log.size() < bytes; n++) {
+		const char* level = (random() % 100000 == 0) ? "ERROR connection reset" : levels[random() % 4];
+		int len = std::snprintf(line, sizeof(line), "2026-10-19T05:%02zu:%02zu.%06zu %s worker-%zu request %zu served in %zu us\n",
+		                        n / 60 % 60, n % 60, n % 1000000, level, n % 16, n, random() % 5000);
+		log.append(line, len);
+	}
+	return log;
+}
+
+void benchSearcher(size_t mebibytes) {
+	struct Needle { constexpr static const char* str() { return "ERROR connection reset"; } };
+	using Searcher = static_string::searcher<static_string::from_provider<Needle>>;
+	const std::string needle = Needle::str();
+
+	const std::string log = makeLog(mebibytes << 20);
+	const char* first = log.data();
+	const char* last = log.data() + log.size();
+
+	auto count = [&](auto&& search) {
+		size_t n = 0;
+		for(const char* p = first; (p = search(p)) != last; p += needle.size()) {
+			n++;
+		}
+		return n;
+	};
+
+	std::printf("searcher (%zu MiB of log data)\n", mebibytes);
+	throughput("static_string::searcher", log.size(), [&] {
+		return count([&](const char* p) { return Searcher::search(p, last); });
+	});
+	throughput("static_string::searcher horspool", log.size(), [&] {
+		return count([&](const char* p) { return Searcher::horspool(p, last); });
+	});
+	throughput("static_string::searcher kmp", log.size(), [&] {
+		return count([&](const char* p) { return Searcher::kmp(p, last); });
+	});
+	throughput("std::search", log.size(), [&] {
+		return count([&](const char* p) { return std::search(p, last, needle.begin(), needle.end()); });
+	});
+	throughput("memmem", log.size(), [&] {
+		return count([&](const char* p) {
+			const void* found = memmem(p, last - p, needle.data(), needle.size());
+			return found ? static_cast<const char*>(found) : last;
+		});
+	});
+	std::experimental::boyer_moore_horspool_searcher<std::string::const_iterator> bmh(needle.begin(), needle.end());
+	throughput("boyer_moore_horspool_searcher", log.size(), [&] {
+		return count([&](const char* p) { return bmh(p, last); });
+	});
+}
+
+
+void benchFormatter() {
+	struct Line { constexpr static const char* str() { return "%s worker-%02d request %zu served in %.3f ms\n"; } };
+	using Format = static_string::formatter<static_string::from_provider<Line>>;
+	const char* levels[] = { "INFO", "DEBUG", "WARN", "TRACE" };
+	const size_t count = 1000000;
+	char buffer[256];
+
+	std::printf("formatter (%zu lines)\n", count);
+	measure("static_string::formatter", count, [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < count; i++) {
+			sum += Format::format(buffer, sizeof(buffer), levels[i % 4], int(i % 16), i, i * 0.001);
+		}
+		return sum;
+	});
+	measure("snprintf", count, [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < count; i++) {
+			sum += std::snprintf(buffer, sizeof(buffer), Line::str(), levels[i % 4], int(i % 16), i, i * 0.001);
+		}
+		return sum;
+	});
+	measure("std::ostringstream", count, [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < count; i++) {
+			std::ostringstream out;
+			out.precision(3);
+			out << std::fixed << levels[i % 4] << " worker-";
+			out.width(2);
+			out.fill('0');
+			out << int(i % 16) << " request " << i << " served in " << i * 0.001 << " ms\n";
+			sum += out.str().size();
+		}
+		return sum;
+	});
+}
+
+
+namespace headers {
+	KEYWORD(ContentLength,   "content-length");
+	KEYWORD(Length,          "length");
+	KEYWORD(ContentType,     "content-type");
+	KEYWORD(Type,            "type");
+	KEYWORD(UserAgent,       "user-agent");
+	KEYWORD(Agent,           "agent");
+	KEYWORD(Accept,          "accept");
+	KEYWORD(AcceptEncoding,  "accept-encoding");
+	KEYWORD(ContentEncoding, "content-encoding");
+	KEYWORD(Encoding,        "encoding");
+	KEYWORD(Cookie,          "cookie");
+	KEYWORD(SetCookie,       "set-cookie");
+	KEYWORD(Host,            "host");
+	KEYWORD(XForwardedHost,  "x-forwarded-host");
+	KEYWORD(Connection,      "connection");
+	KEYWORD(Connection2,     "connection");
+}
+
+template <typename... SSs>
+size_t separateStorage() {
+	size_t sizes[] = { sizeof(SSs::data)... };
+	size_t total = 0;
+	for(size_t size : sizes) {
+		total += size;
+	}
+	return total;
+}
+
+void benchPool() {
+	using namespace headers;
+	using Pool = static_string::pool<
+		static_string::from_provider<ContentLength>,  static_string::from_provider<Length>,
+		static_string::from_provider<ContentType>,    static_string::from_provider<Type>,
+		static_string::from_provider<UserAgent>,      static_string::from_provider<Agent>,
+		static_string::from_provider<Accept>,         static_string::from_provider<AcceptEncoding>,
+		static_string::from_provider<ContentEncoding>,static_string::from_provider<Encoding>,
+		static_string::from_provider<Cookie>,         static_string::from_provider<SetCookie>,
+		static_string::from_provider<Host>,           static_string::from_provider<XForwardedHost>,
+		static_string::from_provider<Connection>,     static_string::from_provider<Connection2>>;
+	size_t separate = separateStorage<
+		static_string::from_provider<ContentLength>,  static_string::from_provider<Length>,
+		static_string::from_provider<ContentType>,    static_string::from_provider<Type>,
+		static_string::from_provider<UserAgent>,      static_string::from_provider<Agent>,
+		static_string::from_provider<Accept>,         static_string::from_provider<AcceptEncoding>,
+		static_string::from_provider<ContentEncoding>,static_string::from_provider<Encoding>,
+		static_string::from_provider<Cookie>,         static_string::from_provider<SetCookie>,
+		static_string::from_provider<Host>,           static_string::from_provider<XForwardedHost>,
+		static_string::from_provider<Connection>,     static_string::from_provider<Connection2>>();
+
+	const std::vector<std::string> names = {
+		"content-length", "length", "content-type", "type", "user-agent", "agent", "accept", "accept-encoding",
+		"content-encoding", "encoding", "cookie", "set-cookie", "host", "x-forwarded-host", "connection",
+		"referer", "origin",
+	};
+	std::unordered_map<std::string, size_t> hash;
+	for(size_t i = 0; i < names.size(); i++) {
+		hash[names[i]] = i;
+	}
+
+	std::mt19937 random(42);
+	std::vector<std::string> inputs;
+	std::vector<Pool::handle> handles;
+	for(size_t i = 0; i < 1000000; i++) {
+		inputs.push_back(names[random() % names.size()]);
+		handles.push_back(Pool::find(inputs.back()));
+	}
+	const Pool::handle host = Pool::handle_of<static_string::from_provider<Host>>::value;
+	const std::string hostName = "host";
+
+	std::printf("pool (%d strings, %d bytes pooled vs %zu bytes separate)\n", int(Pool::count), int(Pool::size), separate);
+	measure("static_string::pool::find", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			sum += Pool::find(s.data(), s.size());
+		}
+		return sum;
+	});
+	measure("std::unordered_map::find", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			auto it = hash.find(s);
+			sum += (it == hash.end()) ? 0 : it->second;
+		}
+		return sum;
+	});
+	measure("handle compare", handles.size(), [&] {
+		size_t sum = 0;
+		for(Pool::handle h : handles) {
+			sum += (h == host);
+		}
+		return sum;
+	});
+	measure("std::string compare", inputs.size(), [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			sum += (s == hostName);
+		}
+		return sum;
+	});
+}
+
+
+void benchRegex(size_t count) {
+	struct Pattern { constexpr static const char* str() { return "([a-z]+)-(\\d+)"; } };
+	using Regex = static_string::regex<static_string::from_provider<Pattern>>;
+	const std::regex expected("([a-z]+)-(\\d+)");
+
+	const std::vector<std::string> samples = {
+		"shard-42", "worker-7", "x-", "node-1234", "Host-1", "abc", "replica-0009", "-1",
+	};
+	std::vector<std::string> inputs;
+	for(size_t i = 0; i < count; i++) {
+		inputs.push_back(samples[i % samples.size()]);
+	}
+
+	std::printf("regex (%zu inputs)\n", count);
+	measure("static_string::regex::match", count, [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			sum += Regex::match(s);
+		}
+		return sum;
+	});
+	measure("static_string::regex::match captures", count, [&] {
+		size_t sum = 0;
+		Regex::match_results results;
+		for(const std::string& s : inputs) {
+			sum += Regex::match(s, results) ? results[2].begin : 0;
+		}
+		return sum;
+	});
+	measure("std::regex_match", count, [&] {
+		size_t sum = 0;
+		for(const std::string& s : inputs) {
+			sum += std::regex_match(s, expected);
+		}
+		return sum;
+	});
+	measure("std::regex_match captures", count, [&] {
+		size_t sum = 0;
+		std::smatch results;
+		for(const std::string& s : inputs) {
+			sum += std::regex_match(s, results, expected) ? results.position(2) : 0;
+		}
+		return sum;
+	});
+}
+
+
+void benchCsvParser(size_t mebibytes) {
+	struct Header { constexpr static const char* str() { return "id,host,status,bytes,latency"; } };
+	using Parser = static_string::csv_parser<static_string::from_provider<Header>,
+	                                         static_string::type_list<long, std::string, int, unsigned long, double>>;
+
+	const char* path = "bench-static-strings.csv";
+	{
+		std::mt19937 random(42);
+		std::ofstream file(path);
+		file << Header::str() << '\n';
+		char line[128];
+		for(size_t n = 0, size = 0; size < (mebibytes << 20); n++) {
+			int len = std::snprintf(line, sizeof(line), "%zu,host-%zu.example.com,%d,%zu,%zu.%03zu\n",
+			                        n, n % 64, 200 + int(random() % 4) * 100, random() % 100000, random() % 1000, random() % 1000);
+			file.write(line, len);
+			size += len;
+		}
+	}
+
+	static_string::mapped_file file(path);
+	const size_t bytes = file.end() - file.begin();
+	const char* body = Parser::skip_header(file.begin(), file.end());
+
+	std::printf("csv parser (%zu MiB)\n", mebibytes);
+	throughput("static_string::csv_parser", bytes, [&] {
+		Parser::columns_type table;
+		return Parser::parse(body, file.end(), table, 2);
+	});
+	unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+	for(unsigned threads = 2; threads <= cores; threads *= 2) {
+		std::string name = "static_string::csv_parser x" + std::to_string(threads);
+		throughput(name.c_str(), bytes, [&] {
+			Parser::columns_type table;
+			return Parser::parse_parallel(body, file.end(), table, threads, 2);
+		});
+	}
+	throughput("std::getline + std::stringstream", bytes, [&] {
+		std::ifstream in(path);
+		std::string line;
+		std::getline(in, line);
+		std::vector<long> ids;
+		std::vector<std::string> hosts;
+		std::vector<int> statuses;
+		std::vector<unsigned long> sizes;
+		std::vector<double> latencies;
+		while(std::getline(in, line)) {
+			std::stringstream fields(line);
+			std::string field;
+			std::getline(fields, field, ',');
+			ids.push_back(std::stol(field));
+			std::getline(fields, field, ',');
+			hosts.push_back(field);
+			std::getline(fields, field, ',');
+			statuses.push_back(std::stoi(field));
+			std::getline(fields, field, ',');
+			sizes.push_back(std::stoul(field));
+			std::getline(fields, field, ',');
+			latencies.push_back(std::stod(field));
+		}
+		return ids.size();
+	});
+	std::remove(path);
+}
+
+
+void benchTranscode(size_t mebibytes) {
+	std::mt19937 random(42);
+	const char* words[] = { "latency", "request", "caf\xC3\xA9", "\xE2\x82\xAC" "42", "\xF0\x9F\x98\x80", "status" };
+	std::string ascii;
+	std::string mixed;
+	while(mixed.size() < (mebibytes << 20)) {
+		ascii += "request latency status ";
+		mixed += words[random() % 6];
+		mixed += (random() % 8 == 0) ? " " : "abcdefghijklmnopqrstuvwxyz ";
+	}
+	ascii.resize(mixed.size());
+
+	std::printf("utf transcoding (%zu MiB)\n", mebibytes);
+	std::u16string out(mixed.size(), u'\0');
+	for(const std::string* input : { &ascii, &mixed }) {
+		const char* kind = (input == &ascii) ? "ascii" : "mixed";
+		std::string name = std::string("static_string::utf 8->16 ") + kind;
+		throughput(name.c_str(), input->size(), [&] {
+			return static_string::utf::transcode(input->data(), input->size(), &out[0]).written;
+		});
+		name = std::string("std::wstring_convert 8->16 ") + kind;
+		throughput(name.c_str(), input->size(), [&] {
+			std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+			return convert.from_bytes(*input).size();
+		});
+	}
+	std::u16string wide = static_string::utf::transcode<char16_t>(mixed);
+	std::string narrow(static_string::utf::max_length<char16_t, char>(wide.size()), '\0');
+	throughput("static_string::utf 16->8 mixed", wide.size() * 2, [&] {
+		return static_string::utf::transcode(wide.data(), wide.size(), &narrow[0]).written;
+	});
+	throughput("std::wstring_convert 16->8 mixed", wide.size() * 2, [&] {
+		std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+		return convert.to_bytes(wide).size();
+	});
+}
+
+
+void benchDigests(size_t mebibytes) {
+	std::mt19937 random(42);
+	std::vector<unsigned char> blob(mebibytes << 20);
+	for(unsigned char& b : blob) {
+		b = static_cast<unsigned char>(random());
+	}
+
+	std::printf("digests (%zu MiB)\n", mebibytes);
+	throughput("static_string::digest::crc32c", blob.size(), [&] {
+		return size_t(static_string::digest::crc32c(blob.data(), blob.size()));
+	});
+	throughput("static_string::digest::crc32c_scalar", blob.size(), [&] {
+		return size_t(static_string::digest::crc32c_scalar(blob.data(), blob.size()));
+	});
+	throughput("static_string::digest::sha256", blob.size(), [&] {
+		return size_t(static_string::digest::sha256(blob.data(), blob.size()).bytes[0]);
+	});
+	throughput("static_string::digest::sha256_scalar", blob.size(), [&] {
+		return size_t(static_string::digest::sha256_scalar(blob.data(), blob.size()).bytes[0]);
+	});
+}
+
+
+#define SCHEMA_FIELD(NAME, TYPE, DESCRIPTION) \
+	"    \"" NAME "\": {\n" \
+	"      \"type\": \"" TYPE "\",\n" \
+	"      \"description\": \"" DESCRIPTION "\"\n" \
+	"    },\n"
+
+struct Schema { constexpr static const char* str() {
+	return "{\n"
+	       "  \"$schema\": \"http://json-schema.org/draft-07/schema#\",\n"
+	       "  \"title\": \"request log record\",\n"
+	       "  \"type\": \"object\",\n"
+	       "  \"properties\": {\n"
+	       SCHEMA_FIELD("id",         "integer", "Monotonic identifier of the record within its file")
+	       SCHEMA_FIELD("timestamp",  "string",  "Time the request was received, in RFC 3339 format")
+	       SCHEMA_FIELD("host",       "string",  "Fully qualified name of the host that served the request")
+	       SCHEMA_FIELD("method",     "string",  "HTTP method of the request, in upper case")
+	       SCHEMA_FIELD("path",       "string",  "Path of the request URI, without the query string")
+	       SCHEMA_FIELD("query",      "string",  "Query string of the request URI, without the leading question mark")
+	       SCHEMA_FIELD("status",     "integer", "HTTP status code returned to the client")
+	       SCHEMA_FIELD("bytes",      "integer", "Number of bytes in the response body")
+	       SCHEMA_FIELD("latency",    "number",  "Time between receiving the request and sending the last byte, in milliseconds")
+	       SCHEMA_FIELD("client",     "string",  "Address of the client, as seen by the host")
+	       SCHEMA_FIELD("agent",      "string",  "Value of the User-Agent header sent by the client")
+	       SCHEMA_FIELD("referrer",   "string",  "Value of the Referer header sent by the client")
+	       SCHEMA_FIELD("protocol",   "string",  "Protocol version used by the client, such as HTTP/1.1 or HTTP/2")
+	       SCHEMA_FIELD("tls",        "boolean", "Whether the connection was encrypted with TLS")
+	       SCHEMA_FIELD("cipher",     "string",  "Name of the TLS cipher suite, when the connection was encrypted")
+	       SCHEMA_FIELD("upstream",   "string",  "Name of the upstream service that produced the response")
+	       SCHEMA_FIELD("retries",    "integer", "Number of times the request was retried against the upstream service")
+	       SCHEMA_FIELD("cache",      "string",  "Result of the cache lookup: hit, miss, stale or bypass")
+	       SCHEMA_FIELD("region",     "string",  "Region of the host that served the request")
+	       SCHEMA_FIELD("trace",      "string",  "Identifier of the distributed trace the request belongs to")
+	       "    \"tags\": {\n"
+	       "      \"type\": \"array\",\n"
+	       "      \"description\": \"Free-form labels attached to the request by the host\"\n"
+	       "    }\n"
+	       "  },\n"
+	       "  \"required\": [\"id\", \"timestamp\", \"host\", \"method\", \"path\", \"status\"]\n"
+	       "}\n";
+} };
+
+#undef SCHEMA_FIELD
+
+void benchCompressed() {
+	using Compressed = static_string::compressed<Schema>;
+	const size_t rounds = 100000;
+	const size_t bytes = Compressed::size * rounds;
+
+	std::printf("compressed static_string (%d bytes embedded as %d, %.1f%% smaller)\n",
+	            Compressed::size, Compressed::compressed_size, 100.0 - 100.0 * Compressed::compressed_size / Compressed::size);
+	std::vector<char> buffer(Compressed::size);
+	throughput("static_string::compressed::decompress", bytes, [&] {
+		size_t sum = 0;
+		for(size_t i = 0; i < rounds; i++) {
+			Compressed::decompress(buffer.data());
+			sum += buffer[i % buffer.size()];
+		}
+		return sum;
+	});
+	throughput("static_string::compressed::stream (4 KiB)", bytes, [&] {
+		size_t sum = 0;
+		char chunk[4096];
+		for(size_t i = 0; i < rounds; i++) {
+			Compressed::stream stream;
+			while(!stream.done()) {
+				sum += stream.read(chunk, sizeof(chunk));
+			}
+		}
+		return sum;
+	});
+	throughput("std::memcpy of the uncompressed text", bytes, [&] {
+		size_t sum = 0;
+		const char* text = Schema::str();
+		for(size_t i = 0; i < rounds; i++) {
+			std::memcpy(buffer.data(), text, buffer.size());
+			sum += buffer[i % buffer.size()];
+		}
+		return sum;
+	});
+}
+
+
+int main(int argc, char* argv[]) {
+	size_t mebibytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 64;
+
+	benchTrie();
+	benchLookup();
+	benchEnumNames();
+	benchCaseInsensitive();
+	benchSearcher(mebibytes);
+	benchFormatter();
+	benchPool();
+	benchRegex(1000000);
+	benchCsvParser(mebibytes);
+	benchTranscode(mebibytes);
+	benchDigests(mebibytes);
+	benchCompressed();
+}
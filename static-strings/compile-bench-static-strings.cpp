@@ -0,0 +1,171 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+// Generates one translation unit per operation and string length, compiles
+// each of them and reports compile time, peak compiler RSS and object size.
+
+const char* DIRECTORY = "compile-bench";
+
+
+struct result {
+	std::string operation;
+	size_t length;
+	bool ok;
+	double seconds;
+	long peak_kib;
+	long object_bytes;
+};
+
+
+std::string text(size_t length, size_t seed) {
+	std::string result;
+	for(size_t i = 0; i < length; i++) {
+		result += char('a' + (i * 7 + seed) % 25);
+	}
+	if(length > 0) {
+		result[length - 1] = 'z';
+	}
+	return result;
+}
+
+std::string provider(const char* name, const std::string& str) {
+	return std::string("struct ") + name + " { constexpr static const char* str() { return \"" + str + "\"; } };\n";
+}
+
+std::string source(const std::string& operation, size_t length) {
+	std::string code = "#include \"../static-strings.hpp\"\n#include <cstddef>\n\n";
+	if(operation == "include") {
+		return code + "int use() { return 0; }\n";
+	}
+	if(operation == "concat") {
+		code += provider("First", text(length / 2, 0));
+		code += provider("Second", text(length - length / 2, 1));
+		code += "using S = static_string::concat<static_string::from_provider<First>, static_string::from_provider<Second>>;\n";
+		return code + "const char* use() { return S::data; }\n";
+	}
+	code += provider("Text", text(length, 0));
+	code += "using S = static_string::from_provider<Text>;\n";
+	if(operation == "from_provider") {
+		return code + "const char* use() { return S::data; }\n";
+	}
+	if(operation == "find") {
+		return code + "size_t use() { return S::find<'z'>::value; }\n";
+	}
+	if(operation == "rfind") {
+		return code + "size_t use() { return S::rfind<'a'>::value; }\n";
+	}
+	return code + "const char* use() { return S::substring<" + std::to_string(length / 4) + ", "
+	            + std::to_string(length / 2) + ">::data; }\n";
+}
+
+
+// The compiler runs under an intermediate process, so that the peak RSS
+// reported for its children covers this compilation only.
+result compile(const std::string& compiler, const std::string& operation, size_t length) {
+	std::string base = std::string(DIRECTORY) + "/" + operation + "-" + std::to_string(length);
+	std::string cpp = base + ".cpp";
+	std::string object = base + ".o";
+	std::string log = base + ".log";
+	std::ofstream(cpp) << source(operation, length);
+	std::remove(object.c_str());
+
+	int channel[2];
+	if(::pipe(channel) != 0) {
+		std::perror("pipe");
+		std::exit(1);
+	}
+	auto start = std::chrono::steady_clock::now();
+	pid_t intermediate = ::fork();
+	if(intermediate == 0) {
+		::close(channel[0]);
+		pid_t child = ::fork();
+		if(child == 0) {
+			int fd = ::open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			::dup2(fd, STDERR_FILENO);
+			::execlp(compiler.c_str(), compiler.c_str(), "-std=c++1y", "-c", cpp.c_str(), "-o", object.c_str(), (char*)nullptr);
+			::_exit(127);
+		}
+		int status = 0;
+		::waitpid(child, &status, 0);
+		struct rusage usage;
+		::getrusage(RUSAGE_CHILDREN, &usage);
+		long peak = usage.ru_maxrss;
+		if(::write(channel[1], &peak, sizeof(peak)) != sizeof(peak)) {
+			::_exit(126);
+		}
+		::_exit(WIFEXITED(status) ? WEXITSTATUS(status) : 125);
+	}
+	::close(channel[1]);
+	int status = 0;
+	::waitpid(intermediate, &status, 0);
+	auto end = std::chrono::steady_clock::now();
+
+	result r{operation, length, WIFEXITED(status) && WEXITSTATUS(status) == 0, 0, 0, 0};
+	r.seconds = std::chrono::duration<double>(end - start).count();
+	if(::read(channel[0], &r.peak_kib, sizeof(r.peak_kib)) != sizeof(r.peak_kib)) {
+		r.peak_kib = 0;
+	}
+	::close(channel[0]);
+	struct stat st;
+	if(r.ok && ::stat(object.c_str(), &st) == 0) {
+		r.object_bytes = st.st_size;
+	}
+	return r;
+}
+
+
+void report(const std::vector<result>& results) {
+	std::ofstream csv("compile-bench-static-strings.csv");
+	csv << "operation,length,ok,seconds,peak_kib,object_bytes\n";
+	for(const result& r : results) {
+		csv << r.operation << ',' << r.length << ',' << (r.ok ? "true" : "false") << ','
+		    << r.seconds << ',' << r.peak_kib << ',' << r.object_bytes << '\n';
+	}
+
+	std::ofstream json("compile-bench-static-strings.json");
+	json << "[\n";
+	for(size_t i = 0; i < results.size(); i++) {
+		const result& r = results[i];
+		json << "  {\"operation\": \"" << r.operation << "\", \"length\": " << r.length
+		     << ", \"ok\": " << (r.ok ? "true" : "false") << ", \"seconds\": " << r.seconds
+		     << ", \"peak_kib\": " << r.peak_kib << ", \"object_bytes\": " << r.object_bytes
+		     << (i + 1 < results.size() ? "},\n" : "}\n");
+	}
+	json << "]\n";
+}
+
+
+int main(int argc, char* argv[]) {
+	size_t maximum = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 16384;
+	std::string compiler = (argc > 2) ? argv[2] : "g++";
+	const char* operations[] = { "from_provider", "concat", "find", "rfind", "substring" };
+
+	::mkdir(DIRECTORY, 0755);
+	std::vector<result> results;
+	auto run = [&](const char* operation, size_t length) {
+		results.push_back(compile(compiler, operation, length));
+		const result& r = results.back();
+		std::printf("  %-14s %6zu  %-6s %8.2f s  %8ld KiB  %8ld bytes\n",
+		            r.operation.c_str(), r.length, r.ok ? "ok" : "FAILED", r.seconds, r.peak_kib, r.object_bytes);
+		std::fflush(stdout);
+	};
+	run("include", 0);
+	for(size_t length = 16; length <= maximum; length *= 4) {
+		for(const char* operation : operations) {
+			run(operation, length);
+		}
+	}
+	report(results);
+}
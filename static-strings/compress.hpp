@@ -0,0 +1,307 @@
+#ifndef STATIC_STRINGS_COMPRESS_HPP_
+#define STATIC_STRINGS_COMPRESS_HPP_
+
+#include "static-strings.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+
+namespace static_string {
+
+
+namespace __impl {
+namespace lz {
+
+
+	// LZ4-style sequences: a token byte holding the literal count and the
+	// match length minus MIN_MATCH (15 means "more bytes follow, 255 each"),
+	// the literals, then a little-endian 16-bit offset into the last WINDOW
+	// bytes. The final sequence carries literals only.
+	enum {
+		MIN_MATCH = 4,
+		WINDOW = 4096,
+		HASH_SIZE = 4096,
+		MAX_CHAIN = 32,
+		NONE = static_cast<size_t>(-1),
+	};
+
+	struct counter {
+		size_t size;
+
+		constexpr void put(std::uint8_t) {
+			size++;
+		}
+	};
+
+	template <size_t N>
+	struct bytes {
+		std::uint8_t values[N ? N : 1];
+		size_t size;
+
+		constexpr void put(std::uint8_t b) {
+			values[size++] = b;
+		}
+	};
+
+	template <typename Sink>
+	constexpr void put_length(Sink& sink, size_t length) {
+		for(; length >= 255; length -= 255) {
+			sink.put(255);
+		}
+		sink.put(std::uint8_t(length));
+	}
+
+	template <typename Sink>
+	constexpr void put_sequence(Sink& sink, const char* literals, size_t count, size_t offset, size_t length) {
+		size_t extra = (length >= MIN_MATCH) ? length - MIN_MATCH : 0;
+		sink.put(std::uint8_t((std::min<size_t>(count, 15) << 4) | std::min<size_t>(extra, 15)));
+		if(count >= 15) {
+			put_length(sink, count - 15);
+		}
+		for(size_t k = 0; k < count; k++) {
+			sink.put(std::uint8_t(literals[k]));
+		}
+		if(length >= MIN_MATCH) {
+			sink.put(std::uint8_t(offset));
+			sink.put(std::uint8_t(offset >> 8));
+			if(extra >= 15) {
+				put_length(sink, extra - 15);
+			}
+		}
+	}
+
+	constexpr size_t hash(const char* p) {
+		std::uint32_t v = std::uint32_t(std::uint8_t(p[0])) | (std::uint32_t(std::uint8_t(p[1])) << 8)
+		                | (std::uint32_t(std::uint8_t(p[2])) << 16) | (std::uint32_t(std::uint8_t(p[3])) << 24);
+		return (v * 2654435761u) >> 20;
+	}
+
+	struct chains {
+		size_t head[HASH_SIZE];
+		size_t previous[WINDOW];
+
+		constexpr void insert(const char* in, size_t i) {
+			size_t h = hash(in + i);
+			previous[i % WINDOW] = head[h];
+			head[h] = i;
+		}
+	};
+
+	template <typename Sink>
+	constexpr void compress(const char* in, size_t n, Sink& sink) {
+		chains table{};
+		for(size_t h = 0; h < HASH_SIZE; h++) {
+			table.head[h] = NONE;
+		}
+		size_t anchor = 0;
+		size_t i = 0;
+		while(n >= MIN_MATCH && i <= n - MIN_MATCH) {
+			size_t best = 0;
+			size_t offset = 0;
+			size_t candidate = table.head[hash(in + i)];
+			for(size_t depth = 0; candidate != NONE && i - candidate < WINDOW && depth < MAX_CHAIN; depth++) {
+				size_t length = 0;
+				while(i + length < n && in[candidate + length] == in[i + length]) {
+					length++;
+				}
+				if(length > best) {
+					best = length;
+					offset = i - candidate;
+				}
+				size_t next = table.previous[candidate % WINDOW];
+				candidate = (next != NONE && next < candidate) ? next : NONE;
+			}
+			if(best < MIN_MATCH) {
+				table.insert(in, i++);
+				continue;
+			}
+			put_sequence(sink, in + anchor, i - anchor, offset, best);
+			for(size_t end = i + best; i < end; i++) {
+				if(i <= n - MIN_MATCH) {
+					table.insert(in, i);
+				}
+			}
+			anchor = i;
+		}
+		put_sequence(sink, in + anchor, n - anchor, 0, 0);
+	}
+
+	template <typename Source>
+	struct packer {
+		using contents = contents_of<Source>;
+
+		static constexpr size_t measure() {
+			counter sink{};
+			compress(contents::data, contents::size, sink);
+			return sink.size;
+		}
+
+		enum { size = measure() };
+
+		static constexpr bytes<size> build() {
+			bytes<size> sink{};
+			compress(contents::data, contents::size, sink);
+			return sink;
+		}
+	};
+
+
+	inline size_t read_length(const std::uint8_t*& p, size_t length) {
+		if(length == 15) {
+			std::uint8_t b;
+			do {
+				b = *p++;
+				length += b;
+			} while(b == 255);
+		}
+		return length;
+	}
+
+	inline void copy_match(char* out, size_t offset, size_t length) {
+		const char* from = out - offset;
+		if(offset >= length) {
+			std::memcpy(out, from, length);
+		} else {
+			for(size_t k = 0; k < length; k++) {
+				out[k] = from[k];
+			}
+		}
+	}
+
+	inline void decompress(const std::uint8_t* p, const std::uint8_t* end, char* out) {
+		while(p != end) {
+			std::uint8_t token = *p++;
+			size_t count = read_length(p, token >> 4);
+			std::memcpy(out, p, count);
+			out += count;
+			p += count;
+			if(p == end) {
+				break;
+			}
+			size_t offset = size_t(p[0]) | (size_t(p[1]) << 8);
+			p += 2;
+			size_t length = read_length(p, token & 15) + MIN_MATCH;
+			copy_match(out, offset, length);
+			out += length;
+		}
+	}
+
+
+} /* namespace lz */
+} /* namespace __impl */
+
+
+template <typename Source>
+struct compressed {
+	using contents = __impl::contents_of<Source>;
+	using char_type = typename std::decay<decltype(contents::data[0])>::type;
+	using string_type = std::basic_string<char_type>;
+
+	static_assert(std::is_same<char_type, char>::value, "only char strings can be compressed");
+
+private:
+	using packer = __impl::lz::packer<Source>;
+
+	static constexpr __impl::lz::bytes<packer::size> packed = packer::build();
+
+public:
+	enum { size = contents::size, compressed_size = packer::size };
+
+	static constexpr const std::uint8_t* bytes = packed.values;
+
+	static void decompress(char_type* out) {
+		__impl::lz::decompress(bytes, bytes + compressed_size, out);
+	}
+
+	static string_type string() {
+		string_type result(size, char_type());
+		decompress(&result[0]);
+		return result;
+	}
+
+	// Decoded on first use and kept for the rest of the program.
+	static const char_type* c_str() {
+		static const string_type decoded = string();
+		return decoded.c_str();
+	}
+
+	class stream {
+	public:
+		stream() : p(bytes), literals(0), match(0), match_header(0), offset(0), produced(0) {}
+
+		bool done() const {
+			return produced == size_t(size);
+		}
+
+		size_t read(char_type* out, size_t capacity) {
+			size_t n = 0;
+			while(n < capacity && !done()) {
+				if(literals > 0) {
+					size_t k = std::min(literals, capacity - n);
+					std::memcpy(out + n, p, k);
+					remember(p, k);
+					p += k;
+					literals -= k;
+					n += k;
+				} else if(match > 0) {
+					size_t k = std::min(match, capacity - n);
+					for(size_t i = 0; i < k; i++) {
+						char_type c = window[(produced - offset) % __impl::lz::WINDOW];
+						out[n + i] = c;
+						remember(&c, 1);
+					}
+					match -= k;
+					n += k;
+				} else {
+					std::uint8_t token = *p++;
+					literals = __impl::lz::read_length(p, token >> 4);
+					if(p + literals != bytes + compressed_size) {
+						const std::uint8_t* q = p + literals;
+						offset = size_t(q[0]) | (size_t(q[1]) << 8);
+						q += 2;
+						match = __impl::lz::read_length(q, token & 15) + __impl::lz::MIN_MATCH;
+						match_header = q - (p + literals);
+					} else {
+						match_header = 0;
+					}
+				}
+				if(literals == 0 && match_header > 0) {
+					p += match_header;
+					match_header = 0;
+				}
+			}
+			return n;
+		}
+
+	private:
+		void remember(const void* data, size_t k) {
+			const char_type* s = static_cast<const char_type*>(data);
+			for(size_t i = 0; i < k; i++) {
+				window[produced++ % __impl::lz::WINDOW] = s[i];
+			}
+		}
+
+		const std::uint8_t* p;
+		size_t literals;
+		size_t match;
+		size_t match_header;
+		size_t offset;
+		size_t produced;
+		char_type window[__impl::lz::WINDOW];
+	};
+};
+
+template <typename Source>
+constexpr __impl::lz::bytes<compressed<Source>::packer::size> compressed<Source>::packed;
+
+template <typename Source>
+constexpr const std::uint8_t* compressed<Source>::bytes;
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_COMPRESS_HPP_ */
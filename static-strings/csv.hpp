@@ -0,0 +1,299 @@
+#ifndef STATIC_STRINGS_CSV_HPP_
+#define STATIC_STRINGS_CSV_HPP_
+
+#include "static-strings.hpp"
+#include "mapped-file.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace static_string {
+
+
+class csv_error : public std::runtime_error {
+public:
+	csv_error(const std::string& reason, size_t line)
+		: std::runtime_error(reason + " at line " + std::to_string(line)), reason(reason), line(line)
+	{}
+
+	const std::string reason;
+	const size_t line;
+};
+
+
+namespace __impl {
+namespace csv {
+
+
+	template <char Sep>
+	inline const char* delimiter(const char* p, const char* last) {
+#if defined(__SSE2__)
+		const __m128i sep = _mm_set1_epi8(Sep);
+		const __m128i newline = _mm_set1_epi8('\n');
+		for(; last - p >= 16; p += 16) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, sep), _mm_cmpeq_epi8(block, newline)));
+			if(mask != 0) {
+				return p + __builtin_ctz(mask);
+			}
+		}
+#endif
+		while(p != last && *p != Sep && *p != '\n') {
+			p++;
+		}
+		return p;
+	}
+
+
+	enum status { VALID, INVALID, OUT_OF_RANGE };
+
+	template <typename T, bool = std::is_integral<T>::value, bool = std::is_floating_point<T>::value>
+	struct converter;
+
+	template <typename T>
+	struct converter<T, true, false> {
+		static status convert(const char* p, const char* end, T& value) {
+			using U = typename std::make_unsigned<T>::type;
+			bool negative = false;
+			if(p != end && (*p == '-' || *p == '+')) {
+				negative = (*p == '-');
+				if(negative && !std::is_signed<T>::value) {
+					return INVALID;
+				}
+				p++;
+			}
+			if(p == end) {
+				return INVALID;
+			}
+			const U limit = U(std::numeric_limits<T>::max()) + U(negative);
+			U magnitude = 0;
+			status result = VALID;
+			for(; p != end; p++) {
+				unsigned d = static_cast<unsigned char>(*p) - '0';
+				if(d > 9) {
+					return INVALID;
+				}
+				if(magnitude > (limit - d) / 10) {
+					result = OUT_OF_RANGE;
+				}
+				magnitude = U(magnitude * 10 + d);
+			}
+			value = negative ? T(0 - magnitude) : T(magnitude);
+			return result;
+		}
+	};
+
+	template <typename T>
+	struct converter<T, false, true> {
+		static status convert(const char* p, const char* end, T& value) {
+			static const double POWERS[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+				1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+			};
+			const char* start = p;
+			bool negative = false;
+			if(p != end && (*p == '-' || *p == '+')) {
+				negative = (*p == '-');
+				p++;
+			}
+			std::uint64_t mantissa = 0;
+			int digits = 0;
+			int exponent = 0;
+			bool any = false;
+			for(; p != end && unsigned(*p - '0') <= 9; p++, any = true) {
+				if(digits < 19) {
+					mantissa = mantissa * 10 + (*p - '0');
+					digits += (mantissa != 0);
+				} else {
+					exponent++;
+				}
+			}
+			if(p != end && *p == '.') {
+				for(p++; p != end && unsigned(*p - '0') <= 9; p++, any = true) {
+					if(digits < 19) {
+						mantissa = mantissa * 10 + (*p - '0');
+						digits += (mantissa != 0);
+						exponent--;
+					}
+				}
+			}
+			if(any && p != end && (*p == 'e' || *p == 'E')) {
+				p++;
+				int e = 0;
+				if(converter<int>::convert(p, end, e) != VALID) {
+					return INVALID;
+				}
+				exponent += e;
+				p = end;
+			}
+			if(!any || p != end) {
+				return INVALID;
+			}
+			if(mantissa > (std::uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+				std::string copy(start, end);
+				value = static_cast<T>(std::strtod(copy.c_str(), nullptr));
+				return VALID;
+			}
+			double result = static_cast<double>(mantissa);
+			result = (exponent < 0) ? result / POWERS[-exponent] : result * POWERS[exponent];
+			value = static_cast<T>(negative ? -result : result);
+			return VALID;
+		}
+	};
+
+	template <>
+	struct converter<std::string, false, false> {
+		static status convert(const char* p, const char* end, std::string& value) {
+			value.assign(p, end);
+			return VALID;
+		}
+	};
+
+
+} /* namespace csv */
+} /* namespace __impl */
+
+
+template <typename Header, typename Types, char Sep = ','>
+struct csv_parser;
+
+template <typename Header, typename... Types, char Sep>
+struct csv_parser<Header, type_list<Types...>, Sep> {
+	using names = typename Header::template split<Sep>;
+	using columns_type = std::tuple<std::vector<Types>...>;
+
+	static_assert(std::is_same<typename Header::char_type, char>::value, "headers must be char strings");
+	static_assert(names::size == sizeof...(Types), "header and type list have different column counts");
+
+	enum { columns = sizeof...(Types) };
+
+	static const char* skip_header(const char* first, const char* last) {
+		const char* end = first;
+		while(end != last && *end != '\n') {
+			end++;
+		}
+		const char* content_end = (end != first && end[-1] == '\r') ? end - 1 : end;
+		if(size_t(content_end - first) != size_t(Header::size) || std::memcmp(first, Header::data, Header::size) != 0) {
+			throw csv_error("unexpected header", 1);
+		}
+		return (end == last) ? end : end + 1;
+	}
+
+	static size_t parse(const char* first, const char* last, columns_type& out, size_t line = 1) {
+		size_t rows = 0;
+		while(first != last) {
+			first = parse_row(first, last, out, line + rows, std::index_sequence_for<Types...>());
+			rows++;
+		}
+		return rows;
+	}
+
+	static size_t parse_parallel(const char* first, const char* last, columns_type& out, unsigned threads, size_t line = 1) {
+		if(threads <= 1) {
+			return parse(first, last, out, line);
+		}
+		std::vector<const char*> bounds(1, first);
+		for(unsigned t = 1; t < threads; t++) {
+			const char* cut = first + (last - first) * t / threads;
+			cut = std::max(cut, bounds.back());
+			while(cut != first && cut != last && cut[-1] != '\n') {
+				cut++;
+			}
+			bounds.push_back(cut);
+		}
+		bounds.push_back(last);
+
+		std::vector<columns_type> parts(threads);
+		std::vector<size_t> rows(threads);
+		std::vector<std::exception_ptr> errors(threads);
+		std::vector<std::thread> workers;
+		for(unsigned t = 0; t < threads; t++) {
+			workers.emplace_back([&, t] {
+				try {
+					rows[t] = parse(bounds[t], bounds[t + 1], parts[t]);
+				} catch(const csv_error& e) {
+					size_t offset = std::count(first, bounds[t], '\n');
+					errors[t] = std::make_exception_ptr(csv_error(e.reason, line + offset + e.line - 1));
+				} catch(...) {
+					errors[t] = std::current_exception();
+				}
+			});
+		}
+		for(std::thread& worker : workers) {
+			worker.join();
+		}
+
+		size_t total = 0;
+		for(unsigned t = 0; t < threads; t++) {
+			if(errors[t]) {
+				std::rethrow_exception(errors[t]);
+			}
+			append(out, parts[t], std::index_sequence_for<Types...>());
+			total += rows[t];
+		}
+		return total;
+	}
+
+private:
+	template <size_t... I>
+	static const char* parse_row(const char* p, const char* last, columns_type& out, size_t line, std::index_sequence<I...>) {
+		(void)std::initializer_list<int>{ (p = parse_field<I>(p, last, out, line), 0)... };
+		return p;
+	}
+
+	template <size_t I>
+	static const char* parse_field(const char* p, const char* last, columns_type& out, size_t line) {
+		using T = typename std::tuple_element<I, std::tuple<Types...>>::type;
+		constexpr bool is_last = (I + 1 == columns);
+
+		const char* end = __impl::csv::delimiter<Sep>(p, last);
+		bool at_line_end = (end == last || *end == '\n');
+		if(at_line_end != is_last) {
+			throw csv_error(is_last ? "too many fields" : "too few fields", line);
+		}
+		const char* content_end = (is_last && end != p && end[-1] == '\r') ? end - 1 : end;
+
+		std::vector<T>& column = std::get<I>(out);
+		column.emplace_back();
+		switch(__impl::csv::converter<T>::convert(p, content_end, column.back())) {
+			case __impl::csv::VALID:
+				break;
+			case __impl::csv::INVALID:
+				throw csv_error("invalid value in column " + names::template at<I>::string(), line);
+			case __impl::csv::OUT_OF_RANGE:
+				throw csv_error("value out of range in column " + names::template at<I>::string(), line);
+		}
+		return (end == last) ? end : end + 1;
+	}
+
+	template <size_t... I>
+	static void append(columns_type& out, columns_type& part, std::index_sequence<I...>) {
+		(void)std::initializer_list<int>{
+			(std::get<I>(out).insert(std::get<I>(out).end(),
+			                         std::make_move_iterator(std::get<I>(part).begin()),
+			                         std::make_move_iterator(std::get<I>(part).end())), 0)...
+		};
+	}
+};
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_CSV_HPP_ */
@@ -0,0 +1,365 @@
+#ifndef STATIC_STRINGS_DIGEST_HPP_
+#define STATIC_STRINGS_DIGEST_HPP_
+
+#include "static-strings.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define STATIC_STRINGS_X86_DIGEST 1
+#endif
+
+
+namespace static_string {
+
+
+struct sha256_digest {
+	std::uint8_t bytes[32];
+
+	std::string hex() const {
+		static const char DIGITS[] = "0123456789abcdef";
+		std::string result(64, '0');
+		for(size_t i = 0; i < 32; i++) {
+			result[2 * i] = DIGITS[bytes[i] >> 4];
+			result[2 * i + 1] = DIGITS[bytes[i] & 0xF];
+		}
+		return result;
+	}
+
+	bool operator==(const sha256_digest& other) const {
+		return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+	}
+
+	bool operator!=(const sha256_digest& other) const {
+		return !(*this == other);
+	}
+};
+
+
+namespace __impl {
+namespace digest {
+
+
+	struct crc32c_tables {
+		std::uint32_t slices[8][256];
+	};
+
+	constexpr crc32c_tables make_crc32c_tables() {
+		crc32c_tables result{};
+		for(std::uint32_t i = 0; i < 256; i++) {
+			std::uint32_t crc = i;
+			for(int k = 0; k < 8; k++) {
+				crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78u : 0);
+			}
+			result.slices[0][i] = crc;
+		}
+		for(std::uint32_t i = 0; i < 256; i++) {
+			for(int s = 1; s < 8; s++) {
+				std::uint32_t previous = result.slices[s - 1][i];
+				result.slices[s][i] = (previous >> 8) ^ result.slices[0][previous & 0xFF];
+			}
+		}
+		return result;
+	}
+
+	constexpr crc32c_tables CRC32C = make_crc32c_tables();
+
+
+	constexpr std::uint32_t K[64] = {
+		0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+		0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+		0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+		0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+		0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+		0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+		0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+		0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+	};
+
+	struct sha256_state {
+		std::uint32_t h[8];
+	};
+
+	constexpr sha256_state SHA256_INITIAL = {{
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+	}};
+
+	constexpr std::uint32_t rotr(std::uint32_t x, int n) {
+		return (x >> n) | (x << (32 - n));
+	}
+
+	template <typename Bytes>
+	constexpr void compress(sha256_state& state, const Bytes& bytes, size_t offset) {
+		std::uint32_t w[64] = {};
+		for(size_t t = 0; t < 16; t++) {
+			size_t i = offset + 4 * t;
+			w[t] = (std::uint32_t(bytes[i]) << 24) | (std::uint32_t(bytes[i + 1]) << 16)
+			     | (std::uint32_t(bytes[i + 2]) << 8) | std::uint32_t(bytes[i + 3]);
+		}
+		for(size_t t = 16; t < 64; t++) {
+			std::uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+			std::uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+			w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+		}
+		std::uint32_t a = state.h[0], b = state.h[1], c = state.h[2], d = state.h[3];
+		std::uint32_t e = state.h[4], f = state.h[5], g = state.h[6], h = state.h[7];
+		for(size_t t = 0; t < 64; t++) {
+			std::uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[t] + w[t];
+			std::uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+		state.h[0] += a;
+		state.h[1] += b;
+		state.h[2] += c;
+		state.h[3] += d;
+		state.h[4] += e;
+		state.h[5] += f;
+		state.h[6] += g;
+		state.h[7] += h;
+	}
+
+	constexpr sha256_digest finish(const sha256_state& state) {
+		sha256_digest result{};
+		for(size_t k = 0; k < 32; k++) {
+			result.bytes[k] = std::uint8_t(state.h[k / 4] >> (24 - 8 * (k % 4)));
+		}
+		return result;
+	}
+
+
+	// Code units are digested as their little-endian bytes, which is what
+	// the runtime functions see for the same strings on x86.
+	template <typename Char>
+	struct units {
+		const Char* data;
+		size_t size;
+
+		constexpr size_t bytes() const {
+			return size * sizeof(Char);
+		}
+
+		constexpr std::uint8_t operator[](size_t i) const {
+			return std::uint8_t(static_cast<typename std::make_unsigned<Char>::type>(data[i / sizeof(Char)]) >> (8 * (i % sizeof(Char))));
+		}
+	};
+
+	template <typename Bytes>
+	struct padded {
+		Bytes bytes;
+		size_t size;
+		std::uint64_t total;
+
+		constexpr std::uint8_t operator[](size_t i) const {
+			return (i < size) ? bytes[i]
+			     : (i == size) ? 0x80
+			     : (i >= blocks() * 64 - 8) ? std::uint8_t((total * 8) >> (8 * (blocks() * 64 - 1 - i)))
+			     : 0;
+		}
+
+		constexpr size_t blocks() const {
+			return (size + 9 + 63) / 64;
+		}
+	};
+
+	template <typename Char>
+	constexpr std::uint32_t crc32c(const Char* data, size_t n) {
+		units<Char> bytes{data, n};
+		std::uint32_t crc = 0xFFFFFFFFu;
+		for(size_t i = 0; i < bytes.bytes(); i++) {
+			crc = (crc >> 8) ^ CRC32C.slices[0][(crc ^ bytes[i]) & 0xFF];
+		}
+		return ~crc;
+	}
+
+	template <typename Char>
+	constexpr sha256_digest sha256(const Char* data, size_t n) {
+		padded<units<Char>> message{ units<Char>{data, n}, n * sizeof(Char), n * sizeof(Char) };
+		sha256_state state = SHA256_INITIAL;
+		for(size_t block = 0; block < message.blocks(); block++) {
+			compress(state, message, block * 64);
+		}
+		return finish(state);
+	}
+
+
+} /* namespace digest */
+} /* namespace __impl */
+
+
+template <typename Source>
+struct crc32c {
+	static constexpr std::uint32_t value = __impl::digest::crc32c(__impl::contents_of<Source>::data,
+	                                                              __impl::contents_of<Source>::size);
+};
+
+template <typename Source>
+constexpr std::uint32_t crc32c<Source>::value;
+
+template <typename Source>
+struct sha256 {
+	static constexpr sha256_digest value = __impl::digest::sha256(__impl::contents_of<Source>::data,
+	                                                             __impl::contents_of<Source>::size);
+};
+
+template <typename Source>
+constexpr sha256_digest sha256<Source>::value;
+
+
+namespace digest {
+
+
+inline std::uint32_t crc32c_scalar(const void* data, size_t n, std::uint32_t crc = 0) {
+	const auto& t = __impl::digest::CRC32C.slices;
+	const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+	crc = ~crc;
+	for(; n >= 8; n -= 8, p += 8) {
+		std::uint32_t low;
+		std::uint32_t high;
+		std::memcpy(&low, p, 4);
+		std::memcpy(&high, p + 4, 4);
+		low ^= crc;
+		crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24]
+		    ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+	}
+	for(; n > 0; n--, p++) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+	}
+	return ~crc;
+}
+
+inline sha256_digest sha256_scalar(const void* data, size_t n) {
+	struct raw {
+		const std::uint8_t* p;
+		std::uint8_t operator[](size_t i) const { return p[i]; }
+	};
+	const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+	__impl::digest::sha256_state state = __impl::digest::SHA256_INITIAL;
+	size_t full = n / 64 * 64;
+	for(size_t offset = 0; offset < full; offset += 64) {
+		__impl::digest::compress(state, raw{p}, offset);
+	}
+	__impl::digest::padded<raw> tail{ raw{p + full}, n - full, n };
+	for(size_t block = 0; block < tail.blocks(); block++) {
+		__impl::digest::compress(state, tail, block * 64);
+	}
+	return __impl::digest::finish(state);
+}
+
+
+#if defined(STATIC_STRINGS_X86_DIGEST)
+
+__attribute__((target("sse4.2")))
+inline std::uint32_t crc32c_sse42(const void* data, size_t n, std::uint32_t crc = 0) {
+	const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+	crc = ~crc;
+#if defined(__x86_64__)
+	std::uint64_t wide = crc;
+	for(; n >= 8; n -= 8, p += 8) {
+		std::uint64_t word;
+		std::memcpy(&word, p, 8);
+		wide = _mm_crc32_u64(wide, word);
+	}
+	crc = std::uint32_t(wide);
+#endif
+	for(; n > 0; n--, p++) {
+		crc = _mm_crc32_u8(crc, *p);
+	}
+	return ~crc;
+}
+
+__attribute__((target("sha,sse4.1,ssse3")))
+inline void sha256_blocks_shani(__impl::digest::sha256_state& state, const std::uint8_t* p, size_t blocks) {
+	const __m128i SWAP = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	__m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state.h)), 0xB1);
+	__m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state.h + 4)), 0x1B);
+	__m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+	__m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+	for(; blocks > 0; blocks--, p += 64) {
+		__m128i abef_saved = abef;
+		__m128i cdgh_saved = cdgh;
+		__m128i w[4];
+		for(int i = 0; i < 4; i++) {
+			w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i)), SWAP);
+		}
+		for(int i = 0; i < 16; i++) {
+			__m128i message = _mm_add_epi32(w[i % 4], _mm_loadu_si128(reinterpret_cast<const __m128i*>(__impl::digest::K + 4 * i)));
+			cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+			abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0E));
+			if(i < 12) {
+				__m128i next = _mm_add_epi32(_mm_sha256msg1_epu32(w[i % 4], w[(i + 1) % 4]),
+				                             _mm_alignr_epi8(w[(i + 3) % 4], w[(i + 2) % 4], 4));
+				w[i % 4] = _mm_sha256msg2_epu32(next, w[(i + 3) % 4]);
+			}
+		}
+		abef = _mm_add_epi32(abef, abef_saved);
+		cdgh = _mm_add_epi32(cdgh, cdgh_saved);
+	}
+
+	__m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+	__m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state.h), _mm_blend_epi16(feba, dchg, 0xF0));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state.h + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+inline sha256_digest sha256_shani(const void* data, size_t n) {
+	const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+	__impl::digest::sha256_state state = __impl::digest::SHA256_INITIAL;
+	size_t full = n / 64;
+	sha256_blocks_shani(state, p, full);
+
+	struct raw {
+		const std::uint8_t* p;
+		std::uint8_t operator[](size_t i) const { return p[i]; }
+	};
+	__impl::digest::padded<raw> tail{ raw{p + full * 64}, n - full * 64, n };
+	std::uint8_t last[128];
+	for(size_t i = 0; i < tail.blocks() * 64; i++) {
+		last[i] = tail[i];
+	}
+	sha256_blocks_shani(state, last, tail.blocks());
+	return __impl::digest::finish(state);
+}
+
+#endif
+
+
+inline std::uint32_t crc32c(const void* data, size_t n, std::uint32_t crc = 0) {
+#if defined(STATIC_STRINGS_X86_DIGEST)
+	static const bool hardware = __builtin_cpu_supports("sse4.2");
+	if(hardware) {
+		return crc32c_sse42(data, n, crc);
+	}
+#endif
+	return crc32c_scalar(data, n, crc);
+}
+
+inline sha256_digest sha256(const void* data, size_t n) {
+#if defined(STATIC_STRINGS_X86_DIGEST)
+	static const bool hardware = __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+	if(hardware) {
+		return sha256_shani(data, n);
+	}
+#endif
+	return sha256_scalar(data, n);
+}
+
+
+} /* namespace digest */
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_DIGEST_HPP_ */
@@ -0,0 +1,149 @@
+#ifndef STATIC_STRINGS_ENUMS_HPP_
+#define STATIC_STRINGS_ENUMS_HPP_
+
+#include "static-strings.hpp"
+#include "trie.hpp"
+#include <string>
+#include <type_traits>
+
+
+namespace static_string {
+
+
+template <typename E, E v, typename Name>
+struct enumerator {
+	using name = Name;
+
+	static constexpr E value = v;
+};
+
+template <typename E, E v, typename Name>
+constexpr E enumerator<E, v, Name>::value;
+
+
+namespace __impl {
+namespace enums {
+
+
+	enum { MAX_SPAN_PER_ENUMERATOR = 4, MIN_SPAN = 64 };
+
+	template <typename Char, typename E, size_t Count, size_t Span>
+	struct tables {
+		E values[Count];
+		view<Char> names[Span];
+	};
+
+	// Values are compared in the underlying type of E, and their offsets
+	// taken in its unsigned counterpart, so that no value is out of range.
+	template <typename Char, typename E, typename... Enumerators>
+	struct builder {
+		using underlying = std::underlying_type_t<E>;
+		using offset_type = std::make_unsigned_t<underlying>;
+
+		enum { count = sizeof...(Enumerators) };
+
+		static constexpr underlying minimum() {
+			constexpr E values[] = { Enumerators::value... };
+			underlying result = static_cast<underlying>(values[0]);
+			for(size_t i = 1; i < count; i++) {
+				result = static_cast<underlying>(values[i]) < result ? static_cast<underlying>(values[i]) : result;
+			}
+			return result;
+		}
+
+		static constexpr underlying maximum() {
+			constexpr E values[] = { Enumerators::value... };
+			underlying result = static_cast<underlying>(values[0]);
+			for(size_t i = 1; i < count; i++) {
+				result = static_cast<underlying>(values[i]) > result ? static_cast<underlying>(values[i]) : result;
+			}
+			return result;
+		}
+
+		static constexpr bool contains(E e) {
+			return static_cast<underlying>(e) >= minimum() && static_cast<underlying>(e) <= maximum();
+		}
+
+		static constexpr size_t offset(E e) {
+			return static_cast<size_t>(offset_type(static_cast<offset_type>(static_cast<underlying>(e)) - static_cast<offset_type>(minimum())));
+		}
+
+		static constexpr size_t span = static_cast<size_t>(offset_type(static_cast<offset_type>(maximum()) - static_cast<offset_type>(minimum()))) + 1;
+
+		static_assert(span <= size_t(MIN_SPAN) || span <= size_t(MAX_SPAN_PER_ENUMERATOR) * count,
+		              "enumerator values are too sparse for a dense name table");
+
+		static constexpr tables<Char, E, count, span> build() {
+			constexpr E values[] = { Enumerators::value... };
+			constexpr size_t sizes[] = { size_t(Enumerators::name::size)... };
+			constexpr const Char* datas[] = { Enumerators::name::data... };
+
+			tables<Char, E, count, span> result{};
+			for(size_t k = 0; k < span; k++) {
+				result.names[k] = view<Char>{ datas[0] + sizes[0], 0 };
+			}
+			for(size_t i = count; i > 0; i--) {
+				result.values[i - 1] = values[i - 1];
+				result.names[offset(values[i - 1])] = view<Char>{ datas[i - 1], sizes[i - 1] };
+			}
+			return result;
+		}
+	};
+
+
+} /* namespace enums */
+} /* namespace __impl */
+
+
+template <typename E, typename Enumerator, typename... Enumerators>
+struct enum_names {
+	static_assert(std::is_enum<E>::value, "enum_names needs an enum type");
+
+	using enum_type = E;
+	using char_type = typename Enumerator::name::char_type;
+	using string_type = std::basic_string<char_type>;
+
+	enum { size = 1 + sizeof...(Enumerators) };
+
+private:
+	using builder = __impl::enums::builder<char_type, E, Enumerator, Enumerators...>;
+	using tables = __impl::enums::tables<char_type, E, size, builder::span>;
+	using decoder = trie<typename Enumerator::name, typename Enumerators::name...>;
+
+	static constexpr tables contents = builder::build();
+
+public:
+	static constexpr const E* values = contents.values;
+
+	// Unknown values, including gaps in the table, get an empty name.
+	static constexpr view<char_type> name(E e) {
+		return !builder::contains(e)
+		     ? view<char_type>{ contents.names[0].data + contents.names[0].size, 0 }
+		     : contents.names[builder::offset(e)];
+	}
+
+	static bool parse(const char_type* s, size_t len, E& e) {
+		size_t index = decoder::match(s, len).index;
+		if(index == size_t(NOT_FOUND)) {
+			return false;
+		}
+		e = contents.values[index];
+		return true;
+	}
+
+	static bool parse(const string_type& s, E& e) {
+		return parse(s.data(), s.size(), e);
+	}
+};
+
+template <typename E, typename Enumerator, typename... Enumerators>
+constexpr typename enum_names<E, Enumerator, Enumerators...>::tables enum_names<E, Enumerator, Enumerators...>::contents;
+
+template <typename E, typename Enumerator, typename... Enumerators>
+constexpr const E* enum_names<E, Enumerator, Enumerators...>::values;
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_ENUMS_HPP_ */
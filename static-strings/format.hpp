@@ -0,0 +1,408 @@
+#ifndef STATIC_STRINGS_FORMAT_HPP_
+#define STATIC_STRINGS_FORMAT_HPP_
+
+#include "static-strings.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace static_string {
+
+
+namespace __impl {
+namespace format {
+
+
+	struct spec {
+		bool literal;
+		size_t begin;
+		size_t length;
+		char conversion;
+		bool left;
+		bool zero;
+		size_t width;
+		int precision;
+		size_t argument;
+	};
+
+
+	template <size_t N>
+	struct parsed {
+		spec specs[N + 1];
+		size_t count;
+		size_t arguments;
+		size_t error;
+	};
+
+
+	constexpr bool is_digit(char c) {
+		return c >= '0' && c <= '9';
+	}
+
+	constexpr bool is_conversion(char c) {
+		return c == 'd' || c == 'i' || c == 'u' || c == 'x' || c == 'X' || c == 'o'
+		    || c == 'c' || c == 's' || c == 'f';
+	}
+
+	constexpr bool is_length_modifier(char c) {
+		return c == 'h' || c == 'l' || c == 'z' || c == 'j' || c == 't';
+	}
+
+
+	template <size_t N>
+	constexpr parsed<N> parse(const char* format) {
+		parsed<N> result{};
+		result.error = NOT_FOUND;
+		size_t i = 0;
+		while(i < N) {
+			spec s{};
+			if(format[i] != '%') {
+				s.literal = true;
+				s.begin = i;
+				while(i < N && format[i] != '%') {
+					i++;
+				}
+				s.length = i - s.begin;
+			} else if(i + 1 < N && format[i + 1] == '%') {
+				s.literal = true;
+				s.begin = i + 1;
+				s.length = 1;
+				i += 2;
+			} else {
+				size_t start = i++;
+				for(; i < N && (format[i] == '-' || format[i] == '0'); i++) {
+					s.left = s.left || format[i] == '-';
+					s.zero = s.zero || format[i] == '0';
+				}
+				for(; i < N && is_digit(format[i]); i++) {
+					s.width = s.width * 10 + (format[i] - '0');
+				}
+				s.precision = -1;
+				if(i < N && format[i] == '.') {
+					s.precision = 0;
+					for(i++; i < N && is_digit(format[i]); i++) {
+						s.precision = s.precision * 10 + (format[i] - '0');
+					}
+				}
+				for(; i < N && is_length_modifier(format[i]); i++) {}
+				if(i == N || !is_conversion(format[i])) {
+					result.error = start;
+					return result;
+				}
+				s.conversion = format[i++];
+				s.argument = result.arguments++;
+			}
+			result.specs[result.count++] = s;
+		}
+		return result;
+	}
+
+
+	template <char Conversion, typename T>
+	struct accepts {
+		static constexpr bool value = std::is_integral<T>::value && !std::is_same<T, bool>::value;
+	};
+
+	template <typename T>
+	struct accepts<'f', T> {
+		// A long double would lose its precision in convert(), which
+		// formats doubles.
+		static constexpr bool value = std::is_same<T, float>::value || std::is_same<T, double>::value;
+	};
+
+	template <typename T>
+	struct accepts<'s', T> {
+		static constexpr bool value = std::is_same<T, const char*>::value
+		                           || std::is_same<T, char*>::value
+		                           || std::is_same<T, std::string>::value;
+	};
+
+
+	static const char DIGIT_PAIRS[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+
+	inline char* decimal(char* end, std::uint64_t value) {
+		while(value >= 100) {
+			const char* pair = DIGIT_PAIRS + (value % 100) * 2;
+			value /= 100;
+			*--end = pair[1];
+			*--end = pair[0];
+		}
+		if(value >= 10) {
+			const char* pair = DIGIT_PAIRS + value * 2;
+			*--end = pair[1];
+			*--end = pair[0];
+		} else {
+			*--end = char('0' + value);
+		}
+		return end;
+	}
+
+	inline char* digits(char* end, std::uint64_t value, unsigned base, bool upper) {
+		if(base == 10) {
+			return decimal(end, value);
+		}
+		const char* alphabet = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+		do {
+			*--end = alphabet[value % base];
+			value /= base;
+		} while(value != 0);
+		return end;
+	}
+
+
+	class writer {
+	public:
+		writer(char* buffer, size_t capacity)
+			: buffer(buffer), capacity(capacity), length(0)
+		{}
+
+		void put(const char* s, size_t n) {
+			if(length < capacity) {
+				std::memcpy(buffer + length, s, std::min(n, capacity - length));
+			}
+			length += n;
+		}
+
+		void fill(char c, size_t n) {
+			if(length < capacity) {
+				std::memset(buffer + length, c, std::min(n, capacity - length));
+			}
+			length += n;
+		}
+
+		// zeros are the leading zeros that the precision of an integer
+		// conversion asks for, between the sign and the digits.
+		void field(const spec& s, const char* sign, const char* body, size_t n, size_t zeros = 0) {
+			size_t signs = std::strlen(sign);
+			size_t padding = (s.width > signs + zeros + n) ? s.width - signs - zeros - n : 0;
+			if(s.left) {
+				put(sign, signs);
+				fill('0', zeros);
+				put(body, n);
+				fill(' ', padding);
+			} else if(s.zero) {
+				put(sign, signs);
+				fill('0', padding + zeros);
+				put(body, n);
+			} else {
+				fill(' ', padding);
+				put(sign, signs);
+				fill('0', zeros);
+				put(body, n);
+			}
+		}
+
+		size_t finish() {
+			if(capacity > 0) {
+				buffer[std::min(length, capacity - 1)] = '\0';
+			}
+			return length;
+		}
+
+	private:
+		char* buffer;
+		size_t capacity;
+		size_t length;
+	};
+
+
+	template <typename T>
+	inline void convert(writer& w, const spec& s, T value, std::true_type) {
+		char buffer[24];
+		char* end = buffer + sizeof(buffer);
+		bool negative = false;
+		std::uint64_t magnitude;
+		if(s.conversion == 'd' || s.conversion == 'i') {
+			negative = value < 0;
+			magnitude = negative ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+		} else {
+			magnitude = static_cast<typename std::make_unsigned<T>::type>(value);
+		}
+		if(s.conversion == 'c') {
+			char c = static_cast<char>(value);
+			w.field(s, "", &c, 1);
+			return;
+		}
+		unsigned base = (s.conversion == 'x' || s.conversion == 'X') ? 16 : (s.conversion == 'o') ? 8 : 10;
+		char* begin = digits(end, magnitude, base, s.conversion == 'X');
+		if(s.precision < 0) {
+			w.field(s, negative ? "-" : "", begin, end - begin);
+			return;
+		}
+		// As in printf, the precision is the minimum number of digits, none
+		// for 0 with a precision of 0, and the 0 flag is ignored.
+		spec padded = s;
+		padded.zero = false;
+		size_t n = (magnitude == 0 && s.precision == 0) ? 0 : end - begin;
+		size_t zeros = (size_t(s.precision) > n) ? s.precision - n : 0;
+		w.field(padded, negative ? "-" : "", begin, n, zeros);
+	}
+
+	inline void convert(writer& w, const spec& s, double value, std::false_type) {
+		static const std::uint64_t POWERS[] = {
+			1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+		};
+		int precision = (s.precision < 0) ? 6 : s.precision;
+		const char* sign = std::signbit(value) ? "-" : "";
+		value = std::fabs(value);
+		if(std::isnan(value)) {
+			w.field(s, sign, "nan", 3);
+			return;
+		}
+		if(std::isinf(value)) {
+			w.field(s, sign, "inf", 3);
+			return;
+		}
+		if(precision > 9 || value >= 1e18) {
+			char buffer[512];
+			int n = std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+			w.field(s, sign, buffer, n);
+			return;
+		}
+
+		// value is exactly mantissa * 2^exponent, so value * scale rounds
+		// exactly in 128 bits, ties to the even last kept digit as in glibc.
+		__extension__ typedef unsigned __int128 wide;
+		std::uint64_t scale = POWERS[precision];
+		int exponent;
+		std::uint64_t mantissa = static_cast<std::uint64_t>(std::ldexp(std::frexp(value, &exponent), 53));
+		exponent -= 53;
+		wide scaled = static_cast<wide>(mantissa) * scale;
+		if(exponent >= 0) {
+			scaled <<= exponent;
+		} else if(-exponent >= 120) {
+			scaled = 0;
+		} else {
+			wide half = static_cast<wide>(1) << (-exponent - 1);
+			wide remainder = scaled & (2 * half - 1);
+			scaled >>= -exponent;
+			if(remainder > half || (remainder == half && (scaled & 1) != 0)) {
+				scaled++;
+			}
+		}
+		std::uint64_t integral = static_cast<std::uint64_t>(scaled / scale);
+		std::uint64_t fraction = static_cast<std::uint64_t>(scaled % scale);
+
+		char buffer[32];
+		char* end = buffer + sizeof(buffer);
+		char* begin = end;
+		if(precision > 0) {
+			begin = decimal(end, fraction);
+			while(end - begin < precision) {
+				*--begin = '0';
+			}
+			*--begin = '.';
+		}
+		begin = decimal(begin, integral);
+		w.field(s, sign, begin, end - begin);
+	}
+
+	// As glibc, a null string prints "(null)", or nothing when the
+	// precision is too short to hold it.
+	inline void convert(writer& w, const spec& s, const char* value) {
+		if(value == nullptr) {
+			value = (s.precision >= 0 && s.precision < 6) ? "" : "(null)";
+		}
+		size_t n = std::strlen(value);
+		w.field(s, "", value, (s.precision >= 0) ? std::min(n, size_t(s.precision)) : n);
+	}
+
+	inline void convert(writer& w, const spec& s, const std::string& value) {
+		size_t n = value.size();
+		w.field(s, "", value.data(), (s.precision >= 0) ? std::min(n, size_t(s.precision)) : n);
+	}
+
+	template <typename T>
+	inline typename std::enable_if<std::is_arithmetic<T>::value>::type
+	convert(writer& w, const spec& s, T value) {
+		convert(w, s, value, std::is_integral<T>());
+	}
+
+
+} /* namespace format */
+} /* namespace __impl */
+
+
+template <typename Format>
+struct formatter {
+	static_assert(std::is_same<typename Format::char_type, char>::value, "formats must be char strings");
+
+	enum { size = Format::size };
+
+private:
+	using parsed = __impl::format::parsed<size>;
+
+	static constexpr parsed format_spec = __impl::format::parse<size>(Format::data);
+
+	static_assert(format_spec.error == NOT_FOUND, "invalid conversion in format string");
+
+	template <size_t I, typename Tuple>
+	static void piece(__impl::format::writer& w, const Tuple& args, std::true_type) {
+		w.put(Format::data + format_spec.specs[I].begin, format_spec.specs[I].length);
+	}
+
+	template <size_t I, typename Tuple>
+	static void piece(__impl::format::writer& w, const Tuple& args, std::false_type) {
+		constexpr __impl::format::spec s = format_spec.specs[I];
+		using T = typename std::decay<typename std::tuple_element<s.argument, Tuple>::type>::type;
+		static_assert(__impl::format::accepts<s.conversion, T>::value, "argument type does not match its conversion");
+		__impl::format::convert(w, s, std::get<s.argument>(args));
+	}
+
+	template <typename Tuple, size_t... I>
+	static void pieces(__impl::format::writer& w, const Tuple& args, std::index_sequence<I...>) {
+		(void)std::initializer_list<int>{
+			(piece<I>(w, args, std::integral_constant<bool, format_spec.specs[I].literal>()), 0)...
+		};
+	}
+
+public:
+	enum { arguments = format_spec.arguments };
+
+	template <typename... Args>
+	static size_t format(char* buffer, size_t capacity, const Args&... args) {
+		static_assert(sizeof...(Args) == arguments, "wrong number of arguments for format string");
+		__impl::format::writer w(buffer, capacity);
+		pieces(w, std::tie(args...), std::make_index_sequence<format_spec.count>());
+		return w.finish();
+	}
+
+	template <typename... Args>
+	static std::string string(const Args&... args) {
+		char buffer[256];
+		size_t n = format(buffer, sizeof(buffer), args...);
+		if(n < sizeof(buffer)) {
+			return std::string(buffer, n);
+		}
+		std::string result(n, '\0');
+		format(&result[0], n + 1, args...);
+		return result;
+	}
+};
+
+template <typename Format>
+constexpr typename formatter<Format>::parsed formatter<Format>::format_spec;
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_FORMAT_HPP_ */
@@ -0,0 +1,194 @@
+#ifndef STATIC_STRINGS_ICASE_HPP_
+#define STATIC_STRINGS_ICASE_HPP_
+
+#include "static-strings.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace static_string {
+
+
+namespace __impl {
+namespace icase {
+
+
+	constexpr std::uint64_t ONES = 0x0101010101010101ull;
+	constexpr std::uint64_t HIGH = 0x8080808080808080ull;
+	constexpr std::uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ull;
+
+	// Lower-cases the ASCII letters of eight bytes at once. Bytes with the
+	// high bit set (UTF-8 sequences, Latin-1) are never touched.
+	constexpr std::uint64_t fold(std::uint64_t x) {
+		std::uint64_t heptets = x & ~HIGH;
+		std::uint64_t at_least_a = heptets + (0x80 - 'A') * ONES;
+		std::uint64_t above_z = heptets + (0x80 - 'Z' - 1) * ONES;
+		std::uint64_t upper = at_least_a & ~above_z & ~x & HIGH;
+		return x | (upper >> 2);
+	}
+
+	constexpr std::uint64_t mix(std::uint64_t h) {
+		h *= MULTIPLIER;
+		return h ^ (h >> 32);
+	}
+
+	constexpr std::uint64_t finish(std::uint64_t h) {
+		h ^= h >> 29;
+		h *= 0xBF58476D1CE4E5B9ull;
+		return h ^ (h >> 32);
+	}
+
+	template <typename Char>
+	constexpr std::uint64_t word(const Char* s, size_t n) {
+		std::uint64_t result = 0;
+		for(size_t k = 0; k < n && k < 8; k++) {
+			result |= std::uint64_t(static_cast<unsigned char>(s[k])) << (8 * k);
+		}
+		return result;
+	}
+
+	template <typename Char>
+	constexpr std::uint64_t hash(const Char* s, size_t n) {
+		std::uint64_t h = mix(n ^ MULTIPLIER);
+		for(size_t i = 0; i < n; i += 8) {
+			h = mix(h ^ fold(word(s + i, n - i)));
+		}
+		return finish(h);
+	}
+
+	inline std::uint64_t load(const char* s, size_t n) {
+		std::uint64_t result = 0;
+		std::memcpy(&result, s, n < 8 ? n : 8);
+		return result;
+	}
+
+#if defined(__SSE2__)
+	inline __m128i fold(__m128i x) {
+		__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(x, _mm_set1_epi8('Z' + 1)));
+		return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+	}
+#endif
+
+	// Compares the folded bytes of s with those of key, where only key is
+	// known to be lower case already when KeyFolded is set.
+	template <bool KeyFolded>
+	inline bool equal(const char* s, const char* key, size_t n) {
+		size_t i = 0;
+#if defined(__SSE2__)
+		for(; n - i >= 16; i += 16) {
+			__m128i a = fold(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + i));
+			if(!KeyFolded) {
+				b = fold(b);
+			}
+			if(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF) {
+				return false;
+			}
+		}
+#endif
+		for(; i < n; i += 8) {
+			std::uint64_t b = load(key + i, n - i);
+			if(fold(load(s + i, n - i)) != (KeyFolded ? b : fold(b))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+} /* namespace icase */
+} /* namespace __impl */
+
+
+namespace icase {
+
+
+inline bool equal(const char* a, size_t n, const char* b, size_t m) {
+	return n == m && __impl::icase::equal<false>(a, b, n);
+}
+
+inline bool equal(const std::string& a, const std::string& b) {
+	return equal(a.data(), a.size(), b.data(), b.size());
+}
+
+template <typename SS>
+bool equal(const char* s, size_t n) {
+	static_assert(std::is_same<typename SS::char_type, char>::value, "case-insensitive keys must be char strings");
+	using key = to_lower<SS>;
+	return n == size_t(key::size) && __impl::icase::equal<true>(s, key::data, n);
+}
+
+template <typename SS>
+bool equal(const std::string& s) {
+	return equal<SS>(s.data(), s.size());
+}
+
+inline int compare(const char* a, size_t n, const char* b, size_t m) {
+	size_t common = n < m ? n : m;
+	for(size_t i = 0; i < common; i += 8) {
+		std::uint64_t x = __impl::icase::fold(__impl::icase::load(a + i, common - i));
+		std::uint64_t y = __impl::icase::fold(__impl::icase::load(b + i, common - i));
+		if(x != y) {
+			int shift = __builtin_ctzll(x ^ y) & ~7;
+			return ((x >> shift) & 0xFF) < ((y >> shift) & 0xFF) ? -1 : 1;
+		}
+	}
+	return n < m ? -1 : (n > m ? 1 : 0);
+}
+
+inline int compare(const std::string& a, const std::string& b) {
+	return compare(a.data(), a.size(), b.data(), b.size());
+}
+
+inline std::uint64_t hash(const char* s, size_t n) {
+	std::uint64_t h = __impl::icase::mix(n ^ __impl::icase::MULTIPLIER);
+	for(size_t i = 0; i < n; i += 8) {
+		h = __impl::icase::mix(h ^ __impl::icase::fold(__impl::icase::load(s + i, n - i)));
+	}
+	return __impl::icase::finish(h);
+}
+
+inline std::uint64_t hash(const std::string& s) {
+	return hash(s.data(), s.size());
+}
+
+template <typename SS>
+struct hash_of {
+	static constexpr std::uint64_t value = __impl::icase::hash(SS::data, SS::size);
+};
+
+template <typename SS>
+constexpr std::uint64_t hash_of<SS>::value;
+
+struct hasher {
+	size_t operator()(const std::string& s) const {
+		return static_cast<size_t>(hash(s));
+	}
+};
+
+struct equal_to {
+	bool operator()(const std::string& a, const std::string& b) const {
+		return equal(a, b);
+	}
+};
+
+struct less {
+	bool operator()(const std::string& a, const std::string& b) const {
+		return compare(a, b) < 0;
+	}
+};
+
+
+} /* namespace icase */
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_ICASE_HPP_ */
@@ -0,0 +1,137 @@
+#ifndef STATIC_STRINGS_LOOKUP_HPP_
+#define STATIC_STRINGS_LOOKUP_HPP_
+
+#include "static-strings.hpp"
+#include <string>
+#include <type_traits>
+
+
+namespace static_string {
+
+
+template <typename Key, typename T, T v>
+struct entry {
+	using key = Key;
+	using value_type = T;
+
+	static constexpr T value = v;
+};
+
+template <typename Key, typename T, T v>
+constexpr T entry<Key, T, v>::value;
+
+
+namespace __impl {
+namespace lookup {
+
+
+	template <typename Char, typename T, size_t N>
+	struct tables {
+		view<Char> keys[N ? N : 1];
+		T values[N ? N : 1];
+		view<Char> tree_keys[N ? N : 1];
+		T tree_values[N ? N : 1];
+		size_t tree_index[N ? N : 1];
+	};
+
+	template <typename Char, typename T, typename... Entries>
+	struct builder {
+		enum { count = sizeof...(Entries) };
+
+		using order = sort_order<typename Entries::key...>;
+
+		static constexpr size_t place(tables<Char, T, count>& result, size_t i, size_t k) {
+			if(k <= count) {
+				i = place(result, i, 2 * k);
+				result.tree_keys[k - 1] = result.keys[i];
+				result.tree_values[k - 1] = result.values[i];
+				result.tree_index[k - 1] = i;
+				i = place(result, i + 1, 2 * k + 1);
+			}
+			return i;
+		}
+
+		static constexpr tables<Char, T, count> build() {
+			constexpr size_t sizes[] = { size_t(Entries::key::size)..., 0 };
+			constexpr const Char* datas[] = { Entries::key::data..., nullptr };
+			constexpr T values[] = { Entries::value..., T() };
+			constexpr auto sorted = order::build();
+
+			tables<Char, T, count> result{};
+			for(size_t i = 0; i < count; i++) {
+				result.keys[i] = view<Char>{ datas[sorted.index[i]], sizes[sorted.index[i]] };
+				result.values[i] = values[sorted.index[i]];
+			}
+			place(result, 0, 1);
+			return result;
+		}
+	};
+
+
+} /* namespace lookup */
+} /* namespace __impl */
+
+
+template <typename Entry, typename... Entries>
+struct lookup_table {
+	using char_type = typename Entry::key::char_type;
+	using string_type = typename Entry::key::string_type;
+	using value_type = typename Entry::value_type;
+
+	enum { size = 1 + sizeof...(Entries) };
+
+private:
+	using builder = __impl::lookup::builder<char_type, value_type, Entry, Entries...>;
+	using tables = __impl::lookup::tables<char_type, value_type, size>;
+
+	static constexpr tables contents = builder::build();
+
+public:
+	static constexpr const view<char_type>* keys = contents.keys;
+	static constexpr const value_type* values = contents.values;
+
+	static size_t index(const char_type* s, size_t len) {
+		size_t k = 1;
+		while(k <= size_t(size)) {
+			k = 2 * k + (order(contents.tree_keys[k - 1], s, len) < 0);
+		}
+		k >>= __builtin_ffsll(~static_cast<unsigned long long>(k));
+		if(k == 0 || order(contents.tree_keys[k - 1], s, len) != 0) {
+			return NOT_FOUND;
+		}
+		return contents.tree_index[k - 1];
+	}
+
+	static size_t index(const string_type& s) {
+		return index(s.data(), s.size());
+	}
+
+	static const value_type* find(const char_type* s, size_t len) {
+		size_t i = index(s, len);
+		return (i == size_t(NOT_FOUND)) ? nullptr : &contents.values[i];
+	}
+
+	static const value_type* find(const string_type& s) {
+		return find(s.data(), s.size());
+	}
+
+private:
+	static int order(const view<char_type>& key, const char_type* s, size_t len) {
+		return __impl::compare_chars(key.data, key.size, s, len);
+	}
+};
+
+template <typename Entry, typename... Entries>
+constexpr typename lookup_table<Entry, Entries...>::tables lookup_table<Entry, Entries...>::contents;
+
+template <typename Entry, typename... Entries>
+constexpr const view<typename lookup_table<Entry, Entries...>::char_type>* lookup_table<Entry, Entries...>::keys;
+
+template <typename Entry, typename... Entries>
+constexpr const typename lookup_table<Entry, Entries...>::value_type* lookup_table<Entry, Entries...>::values;
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_LOOKUP_HPP_ */
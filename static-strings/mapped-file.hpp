@@ -0,0 +1,70 @@
+#ifndef STATIC_STRINGS_MAPPED_FILE_HPP_
+#define STATIC_STRINGS_MAPPED_FILE_HPP_
+
+#include <cerrno>
+#include <cstddef>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace static_string {
+
+
+// A read-only mapping of a whole file, for the parsers that work on
+// memory ranges. Failures throw std::system_error with the path.
+class mapped_file {
+public:
+	explicit mapped_file(const char* path) : bytes(nullptr), length(0) {
+		int fd = ::open(path, O_RDONLY);
+		if(fd < 0) {
+			throw std::system_error(errno, std::generic_category(), path);
+		}
+		struct stat st;
+		if(::fstat(fd, &st) != 0) {
+			int code = errno;
+			::close(fd);
+			throw std::system_error(code, std::generic_category(), path);
+		}
+		length = size_t(st.st_size);
+		if(length > 0) {
+			void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(p == MAP_FAILED) {
+				int code = errno;
+				::close(fd);
+				throw std::system_error(code, std::generic_category(), path);
+			}
+			::madvise(p, length, MADV_SEQUENTIAL);
+			bytes = static_cast<const char*>(p);
+		}
+		::close(fd);
+	}
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	~mapped_file() {
+		if(bytes != nullptr) {
+			::munmap(const_cast<char*>(bytes), length);
+		}
+	}
+
+	const char* data() const { return bytes; }
+	size_t size() const      { return length; }
+
+	const char* begin() const { return bytes; }
+	const char* end() const   { return bytes + length; }
+
+private:
+	const char* bytes;
+	size_t length;
+};
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_MAPPED_FILE_HPP_ */
@@ -0,0 +1,217 @@
+#ifndef STATIC_STRINGS_POOL_HPP_
+#define STATIC_STRINGS_POOL_HPP_
+
+#include "static-strings.hpp"
+#include <cstdint>
+#include <type_traits>
+
+
+namespace static_string {
+
+
+namespace __impl {
+namespace pool {
+
+
+	template <typename Char, typename... SSs>
+	struct layout {
+		enum { count = sizeof...(SSs) };
+
+		static constexpr size_t size(size_t i) {
+			constexpr size_t sizes[] = { size_t(SSs::size)..., 0 };
+			return sizes[i];
+		}
+
+		static constexpr Char char_at(size_t i, size_t pos) {
+			constexpr const Char* datas[] = { SSs::data..., nullptr };
+			return datas[i][pos];
+		}
+
+		static constexpr bool is_suffix(size_t i, size_t j) {
+			if(size(i) > size(j)) {
+				return false;
+			}
+			for(size_t k = 1; k <= size(i); k++) {
+				if(char_at(i, size(i) - k) != char_at(j, size(j) - k)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static constexpr size_t owner(size_t i) {
+			size_t best = i;
+			for(size_t j = 0; j < count; j++) {
+				if(is_suffix(i, j) && (size(j) > size(best) || (size(j) == size(best) && j < best))) {
+					best = j;
+				}
+			}
+			return best;
+		}
+
+		static constexpr size_t blob_size() {
+			size_t total = 0;
+			for(size_t i = 0; i < count; i++) {
+				if(owner(i) == i) {
+					total += size(i) + 1;
+				}
+			}
+			return total;
+		}
+
+		static constexpr int compare(size_t i, size_t j) {
+			for(size_t k = 0; k < size(i) && k < size(j); k++) {
+				if(char_at(i, k) != char_at(j, k)) {
+					return char_at(i, k) < char_at(j, k) ? -1 : 1;
+				}
+			}
+			return size(i) < size(j) ? -1 : (size(i) > size(j) ? 1 : 0);
+		}
+	};
+
+
+	template <typename Char, size_t Size, size_t Count>
+	struct blob {
+		Char chars[Size ? Size : 1];
+		std::uint32_t offsets[Count ? Count : 1];
+		std::uint32_t sorted[Count ? Count : 1];
+		size_t distinct;
+
+		template <typename Layout>
+		static constexpr blob build() {
+			blob result{};
+			size_t next = 0;
+			for(size_t i = 0; i < Count; i++) {
+				if(Layout::owner(i) == i) {
+					result.offsets[i] = next;
+					for(size_t k = 0; k < Layout::size(i); k++) {
+						result.chars[next++] = Layout::char_at(i, k);
+					}
+					result.chars[next++] = Char(0);
+				}
+			}
+			for(size_t i = 0; i < Count; i++) {
+				size_t o = Layout::owner(i);
+				result.offsets[i] = result.offsets[o] + (Layout::size(o) - Layout::size(i));
+			}
+
+			for(size_t i = 0; i < Count; i++) {
+				bool duplicate = false;
+				for(size_t j = 0; j < i; j++) {
+					duplicate = duplicate || Layout::compare(i, j) == 0;
+				}
+				if(duplicate) {
+					continue;
+				}
+				size_t k = result.distinct++;
+				for(; k > 0 && Layout::compare(i, result.sorted[k - 1]) < 0; k--) {
+					result.sorted[k] = result.sorted[k - 1];
+				}
+				result.sorted[k] = i;
+			}
+			return result;
+		}
+	};
+
+
+	template <typename SS, typename... SSs>
+	struct index_of;
+
+	template <typename SS, typename... SSs>
+	struct index_of<SS, SS, SSs...> {
+		enum { value = 0 };
+	};
+
+	template <typename SS, typename Other, typename... SSs>
+	struct index_of<SS, Other, SSs...> {
+		enum { value = 1 + index_of<SS, SSs...>::value };
+	};
+
+
+} /* namespace pool */
+} /* namespace __impl */
+
+
+template <typename SS, typename... SSs>
+struct pool {
+	using char_type = typename SS::char_type;
+	using string_type = typename SS::string_type;
+	using handle = std::uint32_t;
+
+	enum { count = 1 + sizeof...(SSs) };
+
+private:
+	using layout = __impl::pool::layout<char_type, SS, SSs...>;
+	using blob = __impl::pool::blob<char_type, layout::blob_size(), count>;
+
+	static constexpr blob contents = blob::template build<layout>();
+
+public:
+	enum { size = layout::blob_size() };
+
+	static constexpr const char_type* data = contents.chars;
+
+	enum { NO_HANDLE = static_cast<handle>(-1) };
+
+	template <typename S>
+	struct handle_of {
+		static constexpr handle value = contents.offsets[__impl::pool::index_of<S, SS, SSs...>::value];
+	};
+
+	static const char_type* c_str(handle h) {
+		return data + h;
+	}
+
+	static string_type string(handle h) {
+		return string_type(c_str(h));
+	}
+
+	static handle find(const char_type* s, size_t len) {
+		size_t low = 0;
+		size_t high = contents.distinct;
+		while(low < high) {
+			size_t middle = (low + high) / 2;
+			size_t i = contents.sorted[middle];
+			int c = compare(s, len, data + contents.offsets[i], layout::size(i));
+			if(c == 0) {
+				return contents.offsets[i];
+			}
+			if(c < 0) {
+				high = middle;
+			} else {
+				low = middle + 1;
+			}
+		}
+		return NO_HANDLE;
+	}
+
+	static handle find(const string_type& s) {
+		return find(s.data(), s.size());
+	}
+
+private:
+	static int compare(const char_type* a, size_t n, const char_type* b, size_t m) {
+		for(size_t k = 0; k < n && k < m; k++) {
+			if(a[k] != b[k]) {
+				return a[k] < b[k] ? -1 : 1;
+			}
+		}
+		return n < m ? -1 : (n > m ? 1 : 0);
+	}
+};
+
+template <typename SS, typename... SSs>
+constexpr typename pool<SS, SSs...>::blob pool<SS, SSs...>::contents;
+
+template <typename SS, typename... SSs>
+constexpr const typename pool<SS, SSs...>::char_type* pool<SS, SSs...>::data;
+
+template <typename SS, typename... SSs>
+template <typename S>
+constexpr typename pool<SS, SSs...>::handle pool<SS, SSs...>::handle_of<S>::value;
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_POOL_HPP_ */
@@ -0,0 +1,727 @@
+#ifndef STATIC_STRINGS_REGEX_HPP_
+#define STATIC_STRINGS_REGEX_HPP_
+
+#include "static-strings.hpp"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+
+namespace static_string {
+
+
+struct regex_span {
+	size_t begin;
+	size_t end;
+};
+
+
+namespace __impl {
+namespace regex {
+
+
+	struct charset {
+		std::uint64_t bits[4];
+
+		constexpr void add(unsigned c) {
+			bits[c >> 6] |= std::uint64_t(1) << (c & 63);
+		}
+
+		constexpr void add(unsigned first, unsigned last) {
+			for(unsigned c = first; c <= last; c++) {
+				add(c);
+			}
+		}
+
+		constexpr void add(const charset& other) {
+			for(size_t i = 0; i < 4; i++) {
+				bits[i] |= other.bits[i];
+			}
+		}
+
+		constexpr void negate() {
+			for(size_t i = 0; i < 4; i++) {
+				bits[i] = ~bits[i];
+			}
+		}
+
+		constexpr bool contains(unsigned c) const {
+			return (bits[c >> 6] >> (c & 63)) & 1;
+		}
+	};
+
+
+	enum state_type { CHARSET, EPSILON, SAVE, MATCH };
+
+	struct state {
+		state_type type;
+		size_t set;
+		size_t out1;
+		size_t out2;
+		size_t slot;
+	};
+
+	template <size_t N>
+	struct nfa {
+		enum { MAX_STATES = 4 * N + 8, MAX_SETS = N + 1 };
+
+		state states[MAX_STATES];
+		charset sets[MAX_SETS];
+		size_t state_count;
+		size_t set_count;
+		size_t start;
+		size_t groups;
+		size_t error;
+	};
+
+
+	struct fragment {
+		size_t start;
+		size_t end;
+	};
+
+	template <size_t N>
+	struct parser {
+		const char* pattern;
+		size_t pos;
+		nfa<N> result;
+
+		constexpr bool ok() const {
+			return result.error == NOT_FOUND;
+		}
+
+		constexpr void fail() {
+			if(ok()) {
+				result.error = pos;
+			}
+		}
+
+		constexpr bool at(char c) const {
+			return pos < N && pattern[pos] == c;
+		}
+
+		constexpr size_t add(state_type type, size_t out1 = NOT_FOUND, size_t out2 = NOT_FOUND, size_t slot = 0) {
+			if(result.state_count == nfa<N>::MAX_STATES) {
+				fail();
+				return 0;
+			}
+			result.states[result.state_count] = state{type, 0, out1, out2, slot};
+			return result.state_count++;
+		}
+
+		constexpr void link(size_t from, size_t to) {
+			result.states[from].out1 = to;
+		}
+
+		constexpr fragment epsilon() {
+			size_t s = add(EPSILON);
+			return {s, s};
+		}
+
+		constexpr fragment set(const charset& cs) {
+			if(result.set_count == nfa<N>::MAX_SETS) {
+				fail();
+				return epsilon();
+			}
+			size_t index = result.set_count++;
+			result.sets[index] = cs;
+			size_t end = add(EPSILON);
+			size_t start = add(CHARSET, end);
+			result.states[start].set = index;
+			return {start, end};
+		}
+
+		constexpr fragment alternation() {
+			fragment left = concatenation();
+			while(ok() && at('|')) {
+				pos++;
+				fragment right = concatenation();
+				size_t end = add(EPSILON);
+				size_t split = add(EPSILON, left.start, right.start);
+				link(left.end, end);
+				link(right.end, end);
+				left = {split, end};
+			}
+			return left;
+		}
+
+		constexpr fragment concatenation() {
+			fragment whole = epsilon();
+			while(ok() && pos < N && !at('|') && !at(')')) {
+				fragment next = repetition();
+				link(whole.end, next.start);
+				whole.end = next.end;
+			}
+			return whole;
+		}
+
+		constexpr fragment repetition() {
+			fragment inner = atom();
+			while(ok() && (at('*') || at('+') || at('?'))) {
+				char quantifier = pattern[pos++];
+				bool lazy = at('?');
+				if(lazy) {
+					pos++;
+				}
+				size_t end = add(EPSILON);
+				size_t split = lazy ? add(EPSILON, end, inner.start) : add(EPSILON, inner.start, end);
+				if(quantifier == '*') {
+					link(inner.end, split);
+					inner = {split, end};
+				} else if(quantifier == '+') {
+					link(inner.end, split);
+					inner = {inner.start, end};
+				} else {
+					link(inner.end, end);
+					inner = {split, end};
+				}
+			}
+			return inner;
+		}
+
+		constexpr fragment atom() {
+			if(pos == N) {
+				fail();
+				return epsilon();
+			}
+			char c = pattern[pos++];
+			switch(c) {
+			case '(':
+				return group();
+			case '[':
+				return set(bracket());
+			case '.': {
+				charset cs{};
+				cs.add('\n');
+				cs.negate();
+				return set(cs);
+			}
+			case '\\':
+				return set(escape());
+			case ')': case '*': case '+': case '?': case '|':
+			case '^': case '$': case '{': case '}': case ']':
+				pos--;
+				fail();
+				return epsilon();
+			default: {
+				charset cs{};
+				cs.add(static_cast<unsigned char>(c));
+				return set(cs);
+			}
+			}
+		}
+
+		constexpr fragment group() {
+			bool capturing = !(at('?') && pos + 1 < N && pattern[pos + 1] == ':');
+			size_t group = 0;
+			if(capturing) {
+				group = ++result.groups;
+			} else {
+				pos += 2;
+			}
+			fragment inner = alternation();
+			if(!at(')')) {
+				fail();
+				return inner;
+			}
+			pos++;
+			if(!capturing) {
+				return inner;
+			}
+			size_t end = add(SAVE, NOT_FOUND, NOT_FOUND, 2 * group + 1);
+			size_t start = add(SAVE, inner.start, NOT_FOUND, 2 * group);
+			link(inner.end, end);
+			return {start, end};
+		}
+
+		constexpr charset escape() {
+			charset cs{};
+			if(pos == N) {
+				fail();
+				return cs;
+			}
+			char c = pattern[pos++];
+			switch(c) {
+			case 'd': case 'D':
+				cs.add('0', '9');
+				break;
+			case 'w': case 'W':
+				cs.add('a', 'z');
+				cs.add('A', 'Z');
+				cs.add('0', '9');
+				cs.add('_');
+				break;
+			case 's': case 'S':
+				cs.add(' ');
+				cs.add('\t', '\r');
+				break;
+			case 'n': cs.add('\n'); break;
+			case 't': cs.add('\t'); break;
+			case 'r': cs.add('\r'); break;
+			case 'f': cs.add('\f'); break;
+			case 'v': cs.add('\v'); break;
+			default:
+				if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+					pos--;
+					fail();
+				}
+				cs.add(static_cast<unsigned char>(c));
+			}
+			if(c == 'D' || c == 'W' || c == 'S') {
+				cs.negate();
+			}
+			return cs;
+		}
+
+		constexpr charset bracket() {
+			charset cs{};
+			bool negated = at('^');
+			if(negated) {
+				pos++;
+			}
+			bool first = true;
+			while(ok() && pos < N && (first || !at(']'))) {
+				first = false;
+				if(at('\\')) {
+					pos++;
+					cs.add(escape());
+					continue;
+				}
+				unsigned low = static_cast<unsigned char>(pattern[pos++]);
+				if(at('-') && pos + 1 < N && pattern[pos + 1] != ']') {
+					unsigned high = static_cast<unsigned char>(pattern[pos + 1]);
+					if(high < low) {
+						fail();
+					}
+					cs.add(low, high);
+					pos += 2;
+				} else {
+					cs.add(low);
+				}
+			}
+			if(!at(']')) {
+				fail();
+			}
+			pos++;
+			if(negated) {
+				cs.negate();
+			}
+			return cs;
+		}
+	};
+
+	template <size_t N>
+	constexpr nfa<N> parse(const char* pattern) {
+		parser<N> p{pattern, 0, {}};
+		p.result.error = NOT_FOUND;
+		fragment body = p.alternation();
+		if(p.pos != N) {
+			p.fail();
+		}
+		size_t match = p.add(MATCH);
+		size_t end = p.add(SAVE, match, NOT_FOUND, 1);
+		size_t start = p.add(SAVE, body.start, NOT_FOUND, 0);
+		p.link(body.end, end);
+		p.result.start = start;
+		return p.result;
+	}
+
+
+	template <size_t States>
+	struct state_set {
+		enum { WORDS = (States + 63) / 64 };
+
+		std::uint64_t words[WORDS];
+
+		constexpr void insert(size_t s) {
+			words[s / 64] |= std::uint64_t(1) << (s % 64);
+		}
+
+		constexpr bool contains(size_t s) const {
+			return (words[s / 64] >> (s % 64)) & 1;
+		}
+
+		constexpr bool operator==(const state_set& other) const {
+			for(size_t i = 0; i < WORDS; i++) {
+				if(words[i] != other.words[i]) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+	template <size_t N>
+	constexpr void close(const nfa<N>& a, state_set<nfa<N>::MAX_STATES>& set) {
+		size_t stack[nfa<N>::MAX_STATES] = {};
+		size_t top = 0;
+		for(size_t s = 0; s < a.state_count; s++) {
+			if(set.contains(s)) {
+				stack[top++] = s;
+			}
+		}
+		while(top > 0) {
+			const state& s = a.states[stack[--top]];
+			if(s.type == EPSILON || s.type == SAVE) {
+				size_t outs[] = { s.out1, s.out2 };
+				for(size_t out : outs) {
+					if(out != NOT_FOUND && !set.contains(out)) {
+						set.insert(out);
+						stack[top++] = out;
+					}
+				}
+			}
+		}
+	}
+
+
+	template <size_t N, size_t Capacity>
+	struct dfa {
+		using set_type = state_set<nfa<N>::MAX_STATES>;
+
+		set_type sets[Capacity];
+		std::uint16_t next[Capacity][256];
+		bool accepting[Capacity];
+		unsigned char classes[256];
+		size_t class_count;
+		size_t count;
+		size_t start;
+		bool overflow;
+		size_t block[Capacity];
+		size_t blocks;
+	};
+
+	template <size_t N, size_t Capacity>
+	constexpr void classify(const nfa<N>& a, dfa<N, Capacity>& d, unsigned char (&representatives)[256]) {
+		for(unsigned b = 0; b < 256; b++) {
+			size_t found = d.class_count;
+			for(size_t c = 0; c < d.class_count && found == d.class_count; c++) {
+				bool same = true;
+				for(size_t k = 0; k < a.set_count && same; k++) {
+					same = a.sets[k].contains(b) == a.sets[k].contains(representatives[c]);
+				}
+				if(same) {
+					found = c;
+				}
+			}
+			if(found == d.class_count) {
+				representatives[d.class_count++] = b;
+			}
+			d.classes[b] = found;
+		}
+	}
+
+	template <size_t N, size_t Capacity>
+	constexpr void minimize(dfa<N, Capacity>& d) {
+		for(size_t s = 0; s < d.count; s++) {
+			d.block[s] = d.accepting[s] ? 1 : 0;
+		}
+		size_t previous = 0;
+		for(;;) {
+			size_t refined[Capacity] = {};
+			size_t blocks = 0;
+			for(size_t s = 0; s < d.count; s++) {
+				refined[s] = NOT_FOUND;
+				for(size_t t = 0; t < s && refined[s] == NOT_FOUND; t++) {
+					bool same = d.block[t] == d.block[s];
+					for(size_t c = 0; c < d.class_count && same; c++) {
+						same = d.block[d.next[t][c]] == d.block[d.next[s][c]];
+					}
+					if(same) {
+						refined[s] = refined[t];
+					}
+				}
+				if(refined[s] == NOT_FOUND) {
+					refined[s] = blocks++;
+				}
+			}
+			for(size_t s = 0; s < d.count; s++) {
+				d.block[s] = refined[s];
+			}
+			if(blocks == previous) {
+				d.blocks = blocks;
+				return;
+			}
+			previous = blocks;
+		}
+	}
+
+	template <size_t N, size_t Capacity>
+	constexpr dfa<N, Capacity> build(const nfa<N>& a, bool unanchored) {
+		using set_type = typename dfa<N, Capacity>::set_type;
+
+		dfa<N, Capacity> d{};
+		unsigned char representatives[256] = {};
+		classify(a, d, representatives);
+
+		set_type initial{};
+		initial.insert(a.start);
+		close(a, initial);
+		d.sets[1] = initial;
+		d.start = 1;
+		d.count = 2;
+
+		for(size_t i = 1; i < d.count; i++) {
+			for(size_t s = 0; s < a.state_count; s++) {
+				d.accepting[i] = d.accepting[i] || (d.sets[i].contains(s) && a.states[s].type == MATCH);
+			}
+			for(size_t c = 0; c < d.class_count; c++) {
+				set_type target = unanchored ? initial : set_type{};
+				for(size_t s = 0; s < a.state_count; s++) {
+					const state& st = a.states[s];
+					if(d.sets[i].contains(s) && st.type == CHARSET && a.sets[st.set].contains(representatives[c])) {
+						target.insert(st.out1);
+					}
+				}
+				close(a, target);
+				size_t j = 0;
+				while(j < d.count && !(d.sets[j] == target)) {
+					j++;
+				}
+				if(j == d.count) {
+					if(d.count == Capacity) {
+						d.overflow = true;
+						return d;
+					}
+					d.sets[d.count++] = target;
+				}
+				d.next[i][c] = j;
+			}
+		}
+
+		minimize(d);
+		return d;
+	}
+
+
+	template <size_t States, size_t Classes>
+	struct tables {
+		unsigned char classes[256];
+		std::uint16_t next[States * Classes ? States * Classes : 1];
+		bool accepting[States ? States : 1];
+		size_t start;
+	};
+
+	template <size_t States, size_t Classes, size_t N, size_t Capacity>
+	constexpr tables<States, Classes> compact(const dfa<N, Capacity>& d) {
+		tables<States, Classes> t{};
+		for(size_t b = 0; b < 256; b++) {
+			t.classes[b] = d.classes[b];
+		}
+		bool done[States ? States : 1] = {};
+		for(size_t s = 0; s < d.count; s++) {
+			size_t b = d.block[s];
+			if(!done[b]) {
+				done[b] = true;
+				t.accepting[b] = d.accepting[s];
+				for(size_t c = 0; c < Classes; c++) {
+					t.next[b * Classes + c] = d.block[d.next[s][c]];
+				}
+			}
+		}
+		t.start = d.block[d.start];
+		return t;
+	}
+
+
+	template <size_t N, size_t Slots>
+	class pike {
+	public:
+		pike(const nfa<N>& a) : a(a), generation(0), mark() {}
+
+		bool run(const char* s, size_t len, bool anchored, size_t (&best)[Slots]) {
+			bool matched = false;
+			list* current = &lists[0];
+			list* next = &lists[1];
+			size_t caps[Slots];
+			reset(caps);
+
+			current->count = 0;
+			generation++;
+			add(*current, a.start, caps, 0);
+			for(size_t pos = 0; ; pos++) {
+				next->count = 0;
+				generation++;
+				for(size_t i = 0; i < current->count; i++) {
+					const state& st = a.states[current->states[i]];
+					if(st.type == MATCH) {
+						if(!anchored || pos == len) {
+							for(size_t k = 0; k < Slots; k++) {
+								best[k] = current->caps[i][k];
+							}
+							matched = true;
+							break;
+						}
+					} else if(pos < len && a.sets[st.set].contains(static_cast<unsigned char>(s[pos]))) {
+						add(*next, st.out1, current->caps[i], pos + 1);
+					}
+				}
+				if(pos == len) {
+					break;
+				}
+				if(!matched && !anchored) {
+					reset(caps);
+					add(*next, a.start, caps, pos + 1);
+				}
+				std::swap(current, next);
+				if(current->count == 0 && (matched || anchored)) {
+					break;
+				}
+			}
+			return matched;
+		}
+
+	private:
+		struct list {
+			size_t count;
+			size_t states[nfa<N>::MAX_STATES];
+			size_t caps[nfa<N>::MAX_STATES][Slots];
+		};
+
+		const nfa<N>& a;
+		size_t generation;
+		size_t mark[nfa<N>::MAX_STATES];
+		list lists[2];
+
+		static void reset(size_t (&caps)[Slots]) {
+			for(size_t k = 0; k < Slots; k++) {
+				caps[k] = NOT_FOUND;
+			}
+		}
+
+		void add(list& l, size_t s, size_t (&caps)[Slots], size_t pos) {
+			if(mark[s] == generation) {
+				return;
+			}
+			mark[s] = generation;
+			const state& st = a.states[s];
+			if(st.type == EPSILON) {
+				add(l, st.out1, caps, pos);
+				if(st.out2 != NOT_FOUND) {
+					add(l, st.out2, caps, pos);
+				}
+			} else if(st.type == SAVE) {
+				size_t saved = caps[st.slot];
+				caps[st.slot] = pos;
+				add(l, st.out1, caps, pos);
+				caps[st.slot] = saved;
+			} else {
+				l.states[l.count] = s;
+				for(size_t k = 0; k < Slots; k++) {
+					l.caps[l.count][k] = caps[k];
+				}
+				l.count++;
+			}
+		}
+	};
+
+
+} /* namespace regex */
+} /* namespace __impl */
+
+
+template <typename Pattern, size_t Capacity = 64>
+struct regex {
+	static_assert(std::is_same<typename Pattern::char_type, char>::value, "patterns must be char strings");
+
+private:
+	enum { N = Pattern::size };
+
+	using nfa = __impl::regex::nfa<N>;
+	using dfa = __impl::regex::dfa<N, Capacity>;
+
+	static constexpr nfa automaton = __impl::regex::parse<N>(Pattern::data);
+	static_assert(automaton.error == NOT_FOUND, "invalid regular expression");
+
+	static constexpr dfa anchored = __impl::regex::build<N, Capacity>(automaton, false);
+	static constexpr dfa unanchored = __impl::regex::build<N, Capacity>(automaton, true);
+	static_assert(!anchored.overflow && !unanchored.overflow, "regular expression needs more DFA states than Capacity");
+
+	using match_tables = __impl::regex::tables<anchored.blocks, anchored.class_count>;
+	using search_tables = __impl::regex::tables<unanchored.blocks, unanchored.class_count>;
+
+	static constexpr match_tables matcher = __impl::regex::compact<anchored.blocks, anchored.class_count>(anchored);
+	static constexpr search_tables searcher = __impl::regex::compact<unanchored.blocks, unanchored.class_count>(unanchored);
+
+	enum { SLOTS = 2 * (automaton.groups + 1) };
+
+	static bool captures(const char* s, size_t len, bool anchored, regex_span* spans) {
+		size_t best[SLOTS];
+		__impl::regex::pike<N, SLOTS> vm(automaton);
+		if(!vm.run(s, len, anchored, best)) {
+			return false;
+		}
+		for(size_t g = 0; g <= groups; g++) {
+			bool set = best[2 * g] != NOT_FOUND && best[2 * g + 1] != NOT_FOUND;
+			spans[g] = set ? regex_span{best[2 * g], best[2 * g + 1]} : regex_span{NOT_FOUND, NOT_FOUND};
+		}
+		return true;
+	}
+
+public:
+	enum { groups = automaton.groups };
+	enum { match_states = anchored.blocks, search_states = unanchored.blocks };
+
+	using match_results = std::array<regex_span, groups + 1>;
+
+	static bool match(const char* s, size_t len) {
+		const size_t classes = anchored.class_count;
+		size_t state = matcher.start;
+		for(size_t i = 0; i < len; i++) {
+			state = matcher.next[state * classes + matcher.classes[static_cast<unsigned char>(s[i])]];
+			if(state == 0) {
+				return false;
+			}
+		}
+		return matcher.accepting[state];
+	}
+
+	static bool search(const char* s, size_t len) {
+		const size_t classes = unanchored.class_count;
+		size_t state = searcher.start;
+		for(size_t i = 0; i < len && !searcher.accepting[state]; i++) {
+			state = searcher.next[state * classes + searcher.classes[static_cast<unsigned char>(s[i])]];
+		}
+		return searcher.accepting[state];
+	}
+
+	static bool match(const char* s, size_t len, match_results& results) {
+		return match(s, len) && captures(s, len, true, results.data());
+	}
+
+	static bool search(const char* s, size_t len, match_results& results) {
+		return search(s, len) && captures(s, len, false, results.data());
+	}
+
+	static bool match(const std::string& s) {
+		return match(s.data(), s.size());
+	}
+
+	static bool search(const std::string& s) {
+		return search(s.data(), s.size());
+	}
+
+	static bool match(const std::string& s, match_results& results) {
+		return match(s.data(), s.size(), results);
+	}
+
+	static bool search(const std::string& s, match_results& results) {
+		return search(s.data(), s.size(), results);
+	}
+};
+
+template <typename Pattern, size_t Capacity>
+constexpr typename regex<Pattern, Capacity>::nfa regex<Pattern, Capacity>::automaton;
+
+template <typename Pattern, size_t Capacity>
+constexpr typename regex<Pattern, Capacity>::match_tables regex<Pattern, Capacity>::matcher;
+
+template <typename Pattern, size_t Capacity>
+constexpr typename regex<Pattern, Capacity>::search_tables regex<Pattern, Capacity>::searcher;
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_REGEX_HPP_ */
@@ -0,0 +1,178 @@
+#ifndef STATIC_STRINGS_SEARCHER_HPP_
+#define STATIC_STRINGS_SEARCHER_HPP_
+
+#include "static-strings.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace static_string {
+
+
+namespace __impl {
+namespace searcher {
+
+
+	enum { SKIP_TABLE_SIZE = 256 };
+
+	template <typename Char>
+	constexpr size_t skip_index(Char c) {
+		return static_cast<size_t>(c) & (SKIP_TABLE_SIZE - 1);
+	}
+
+
+	template <typename Char, size_t N>
+	struct tables {
+		size_t skip[SKIP_TABLE_SIZE];
+		size_t failure[N ? N : 1];
+
+		static constexpr tables build(const Char* needle) {
+			tables result{};
+			for(size_t i = 0; i < SKIP_TABLE_SIZE; i++) {
+				result.skip[i] = N;
+			}
+			for(size_t i = 0; i + 1 < N; i++) {
+				result.skip[skip_index(needle[i])] = N - 1 - i;
+			}
+
+			size_t k = 0;
+			for(size_t i = 1; i < N; i++) {
+				while(k > 0 && needle[i] != needle[k]) {
+					k = result.failure[k - 1];
+				}
+				if(needle[i] == needle[k]) {
+					k++;
+				}
+				result.failure[i] = k;
+			}
+			return result;
+		}
+	};
+
+
+	template <typename Char, size_t N>
+	struct simd {
+		static const Char* search(const Char* first, const Char* last, const Char* needle) {
+			return first;
+		}
+	};
+
+#if defined(__SSE2__)
+	template <size_t N>
+	struct simd<char, N> {
+#if defined(__AVX2__)
+		using vector = __m256i;
+		enum { WIDTH = 32 };
+		static vector splat(char c)           { return _mm256_set1_epi8(c); }
+		static vector load(const char* p)     { return _mm256_loadu_si256(reinterpret_cast<const vector*>(p)); }
+		static unsigned matches(vector a, vector b, vector c, vector d) {
+			return _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, b), _mm256_cmpeq_epi8(c, d)));
+		}
+#else
+		using vector = __m128i;
+		enum { WIDTH = 16 };
+		static vector splat(char c)           { return _mm_set1_epi8(c); }
+		static vector load(const char* p)     { return _mm_loadu_si128(reinterpret_cast<const vector*>(p)); }
+		static unsigned matches(vector a, vector b, vector c, vector d) {
+			return _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, b), _mm_cmpeq_epi8(c, d)));
+		}
+#endif
+
+		static const char* search(const char* first, const char* last, const char* needle) {
+			const vector head = splat(needle[0]);
+			const vector tail = splat(needle[N - 1]);
+			for(; last - first >= static_cast<std::ptrdiff_t>(WIDTH + N - 1); first += WIDTH) {
+				unsigned mask = matches(head, load(first), tail, load(first + N - 1));
+				while(mask != 0) {
+					unsigned bit = __builtin_ctz(mask);
+					if(N <= 2 || std::memcmp(first + bit + 1, needle + 1, N - 2) == 0) {
+						return first + bit;
+					}
+					mask &= mask - 1;
+				}
+			}
+			return first;
+		}
+	};
+#endif
+
+
+} /* namespace searcher */
+} /* namespace __impl */
+
+
+template <typename Needle>
+struct searcher {
+	using char_type = typename Needle::char_type;
+	using string_type = typename Needle::string_type;
+
+	enum { size = Needle::size };
+
+	static const char_type* search(const char_type* first, const char_type* last) {
+		if(size == 0) {
+			return first;
+		}
+		first = __impl::searcher::simd<char_type, size>::search(first, last, Needle::data);
+		return horspool(first, last);
+	}
+
+	static const char_type* horspool(const char_type* first, const char_type* last) {
+		if(size == 0) {
+			return first;
+		}
+		const char_type* needle = Needle::data;
+		for(; last - first >= static_cast<std::ptrdiff_t>(size); first += table.skip[__impl::searcher::skip_index(first[size - 1])]) {
+			if(first[size - 1] == needle[size - 1] && std::equal(needle, needle + size - 1, first)) {
+				return first;
+			}
+		}
+		return last;
+	}
+
+	static const char_type* kmp(const char_type* first, const char_type* last) {
+		if(size == 0) {
+			return first;
+		}
+		const char_type* needle = Needle::data;
+		size_t k = 0;
+		for(; first != last; ++first) {
+			while(k > 0 && *first != needle[k]) {
+				k = table.failure[k - 1];
+			}
+			if(*first == needle[k] && ++k == size) {
+				return first - (size - 1);
+			}
+		}
+		return last;
+	}
+
+	static size_t find(const string_type& s, size_t pos = 0) {
+		if(pos > s.size()) {
+			return NOT_FOUND;
+		}
+		const char_type* end = s.data() + s.size();
+		const char_type* found = search(s.data() + pos, end);
+		return (found == end && size > 0) ? size_t(NOT_FOUND) : size_t(found - s.data());
+	}
+
+private:
+	using tables = __impl::searcher::tables<char_type, size>;
+
+	static constexpr tables table = tables::build(Needle::data);
+};
+
+template <typename Needle>
+constexpr typename searcher<Needle>::tables searcher<Needle>::table;
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_SEARCHER_HPP_ */
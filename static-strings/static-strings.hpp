@@ -2,7 +2,9 @@
 #define STATIC_STRINGS_HPP_
 
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 
 namespace static_string {
@@ -23,6 +25,9 @@ namespace __impl {
 	template <size_t Pos, size_t Len, typename Char, Char... chars>
 	struct substring;
 
+	template <typename SS, typename SS::char_type x>
+	struct split;
+
 
 } /* namespace __impl */
 
@@ -33,6 +38,25 @@ enum { NOT_FOUND = static_cast<size_t>(-1) };
 template <typename Char, Char...>
 struct static_string;
 
+
+template <typename... SSs>
+struct type_list {
+	enum { size = sizeof...(SSs) };
+
+	template <size_t Index>
+	using at = typename std::tuple_element<Index, std::tuple<SSs...>>::type;
+};
+
+template <typename Char>
+struct view {
+	const Char* data;
+	size_t size;
+
+	std::basic_string<Char> string() const {
+		return std::basic_string<Char>(data, size);
+	}
+};
+
 template <typename Char>
 struct static_string<Char> {
 	using char_type = Char;
@@ -40,6 +64,8 @@ struct static_string<Char> {
 
 	enum { size = 0 };
 
+	static constexpr Char data[] = { Char(0) };
+
 	inline static string_type string() {
 		return {};
 	}
@@ -53,6 +79,9 @@ struct static_string<Char> {
 	template <size_t Pos, size_t Len>
 	using substring = typename __impl::substring<Pos, Len, Char>::type;
 
+	template <Char x>
+	using split = typename __impl::split<static_string, x>::type;
+
 private:
 
 	template <typename C, C...> friend struct static_string;
@@ -67,6 +96,8 @@ struct static_string<Char, c, chars...> {
 
 	enum { size = 1 + sizeof...(chars) };
 
+	static constexpr Char data[] = { c, chars..., Char(0) };
+
 	inline static string_type string() {
 		string_type result;
 		result.reserve(size);
@@ -86,6 +117,9 @@ struct static_string<Char, c, chars...> {
 	template <size_t Pos, size_t Len>
 	using substring = typename __impl::substring<Pos, Len, Char, c, chars...>::type;
 
+	template <Char x>
+	using split = typename __impl::split<static_string, x>::type;
+
 private:
 
 	template <typename C, C...> friend struct static_string;
@@ -96,23 +130,22 @@ private:
 	}
 };
 
+template <typename Char>
+constexpr Char static_string<Char>::data[];
+
+template <typename Char, Char c, Char... chars>
+constexpr Char static_string<Char, c, chars...>::data[];
+
 
 namespace __impl {
 
 
-	template <typename StrProvider, size_t len, typename Char, char... chars>
-	struct build_from_provider {
-		using type = typename build_from_provider<StrProvider,
-		                                          len - 1,
-		                                          Char,
-		                                          StrProvider::str()[len - 1],
-		                                          chars...
-		                                         >::type;
-	};
+	template <typename StrProvider, size_t len, typename Char, typename Indices = std::make_index_sequence<len>>
+	struct build_from_provider;
 
-	template <typename StrProvider, typename Char, char... chars>
-	struct build_from_provider<StrProvider, 0, Char, chars...> {
-		using type = static_string<Char, chars...>;
+	template <typename StrProvider, size_t len, typename Char, size_t... I>
+	struct build_from_provider<StrProvider, len, Char, std::index_sequence<I...>> {
+		using type = static_string<Char, StrProvider::str()[I]...>;
 	};
 
 
@@ -137,13 +170,39 @@ namespace __impl {
 	struct size_for<StrProvider, false> {
 		template <typename Char>
 		static constexpr size_t str_length(const Char* str) {
-			return str[0] == Char(0) ? 0 : (1 + str_length(str + 1));
+			size_t length = 0;
+			while(str[length] != Char(0)) {
+				length++;
+			}
+			return length;
 		}
 
 		enum { value = str_length(StrProvider::str()) };
 	};
 
 
+	template <typename T>
+	struct contents_of {
+		template <typename U> static constexpr bool test(decltype(&U::data)) { return true; }  // SFINAE!
+		template <typename U> static constexpr bool test(...) { return false; }
+
+		template <typename U, bool = test<U>(nullptr)>
+		struct of {
+			static constexpr auto data = U::data;
+			enum { size = U::size };
+		};
+
+		template <typename U>
+		struct of<U, false> {
+			static constexpr auto data = U::str();
+			enum { size = size_for<U>::value };
+		};
+
+		static constexpr auto data = of<T>::data;
+		enum { size = of<T>::size };
+	};
+
+
 	template <typename... SSs>
 	struct concat;
 
@@ -201,28 +260,264 @@ namespace __impl {
 	};
 
 
-	template <typename Char, Char... chars>
-	struct substring<0, 0, Char, chars...> {
-		using type = static_string<Char>;
+	template <typename SS, size_t Pos, typename Indices>
+	struct slice;
+
+	template <typename Char, Char... chars, size_t Pos, size_t... I>
+	struct slice<static_string<Char, chars...>, Pos, std::index_sequence<I...>> {
+		using type = static_string<Char, static_string<Char, chars...>::data[Pos + I]...>;
 	};
 
-	template <typename Char, Char c, Char... chars>
-	struct substring<0, 0, Char, c, chars...> {
-		using type = static_string<Char>;
+	template <size_t Pos, size_t Len, typename Char, Char... chars>
+	struct substring {
+		static_assert(Pos + Len <= sizeof...(chars), "substring out of range");
+		using type = typename slice<static_string<Char, chars...>, Pos, std::make_index_sequence<Len>>::type;
+	};
+
+
+	template <size_t N>
+	struct fields {
+		size_t begin[N + 1];
+		size_t end[N + 1];
+		size_t count;
+	};
+
+	template <typename SS, typename SS::char_type x>
+	struct split_positions {
+		static constexpr fields<SS::size> find() {
+			fields<SS::size> result{};
+			for(size_t i = 0; i < size_t(SS::size); i++) {
+				if(SS::data[i] == x) {
+					result.end[result.count++] = i;
+					result.begin[result.count] = i + 1;
+				}
+			}
+			result.end[result.count++] = SS::size;
+			return result;
+		}
+	};
+
+	template <typename SS, typename SS::char_type x>
+	struct split {
+	private:
+		static constexpr auto positions = split_positions<SS, x>::find();
+
+		template <size_t... K>
+		static type_list<typename slice<SS,
+		                                positions.begin[K],
+		                                std::make_index_sequence<positions.end[K] - positions.begin[K]>
+		                               >::type...>
+		make(std::index_sequence<K...>);
+
+	public:
+		using type = decltype(make(std::make_index_sequence<positions.count>()));
+	};
+
+
+	template <typename Char, size_t N>
+	struct joined {
+		Char chars[N ? N : 1];
+	};
+
+	template <typename Sep, typename... SSs>
+	struct join_chars {
+		using Char = typename Sep::char_type;
+
+		static constexpr size_t size() {
+			constexpr size_t sizes[] = { size_t(SSs::size)..., 0 };
+			size_t total = 0;
+			for(size_t i = 0; i < sizeof...(SSs); i++) {
+				total += sizes[i] + (i > 0 ? size_t(Sep::size) : 0);
+			}
+			return total;
+		}
+
+		static constexpr joined<Char, size()> build() {
+			constexpr size_t sizes[] = { size_t(SSs::size)..., 0 };
+			constexpr const Char* datas[] = { SSs::data..., nullptr };
+			joined<Char, size()> result{};
+			size_t n = 0;
+			for(size_t i = 0; i < sizeof...(SSs); i++) {
+				for(size_t k = 0; i > 0 && k < size_t(Sep::size); k++) {
+					result.chars[n++] = Sep::data[k];
+				}
+				for(size_t k = 0; k < sizes[i]; k++) {
+					result.chars[n++] = datas[i][k];
+				}
+			}
+			return result;
+		}
+	};
+
+	template <typename Sep, typename... SSs>
+	struct join {
+	private:
+		using chars = join_chars<Sep, SSs...>;
+		using Char = typename Sep::char_type;
+
+		static constexpr auto result = chars::build();
+
+		template <size_t... I>
+		static static_string<Char, result.chars[I]...> make(std::index_sequence<I...>);
+
+	public:
+		using type = decltype(make(std::make_index_sequence<chars::size()>()));
+	};
+
+	template <typename Sep, typename... SSs>
+	struct join<Sep, type_list<SSs...>> : join<Sep, SSs...> {};
+
+
+	template <typename Char>
+	constexpr int compare_chars(const Char* a, size_t n, const Char* b, size_t m) {
+		using Unit = typename std::conditional<std::is_same<Char, char>::value, unsigned char, Char>::type;
+		for(size_t k = 0; k < n && k < m; k++) {
+			if(a[k] != b[k]) {
+				return Unit(a[k]) < Unit(b[k]) ? -1 : 1;
+			}
+		}
+		return n < m ? -1 : (n > m ? 1 : 0);
+	}
+
+	template <typename SS1, typename SS2>
+	struct compare {
+		static_assert(std::is_same<typename SS1::char_type, typename SS2::char_type>::value, "cannot compare strings of different char types");
+		static constexpr int value = compare_chars(SS1::data, SS1::size, SS2::data, SS2::size);
+	};
+
+
+	template <size_t N>
+	struct permutation {
+		size_t index[N ? N : 1];
+	};
+
+	template <typename... SSs>
+	struct sort_order {
+		enum { count = sizeof...(SSs) };
+
+		static constexpr int compare(size_t i, size_t j) {
+			using Char = typename std::tuple_element<0, std::tuple<typename SSs::char_type...>>::type;
+			constexpr size_t sizes[] = { size_t(SSs::size)..., 0 };
+			constexpr const Char* datas[] = { SSs::data..., nullptr };
+			return compare_chars(datas[i], sizes[i], datas[j], sizes[j]);
+		}
+
+		static constexpr permutation<count> build() {
+			permutation<count> result{};
+			for(size_t i = 0; i < count; i++) {
+				size_t rank = 0;
+				for(size_t j = 0; j < count; j++) {
+					int c = compare(j, i);
+					rank += (c < 0 || (c == 0 && j < i));
+				}
+				result.index[rank] = i;
+			}
+			return result;
+		}
 	};
 
-	template <size_t Len, typename Char, Char c, Char... chars>
-	struct substring<0, Len, Char, c, chars...> {
+	template <typename... SSs>
+	struct sort {
 	private:
-		using first = static_string<Char, c>;
-		using rest = typename substring<0, Len - 1, Char, chars...>::type;
+		static constexpr auto order = sort_order<SSs...>::build();
+
+		template <size_t... I>
+		static type_list<typename type_list<SSs...>::template at<order.index[I]>...> make(std::index_sequence<I...>);
+
 	public:
-		using type = typename concat<first, rest>::type;
+		using type = decltype(make(std::make_index_sequence<sizeof...(SSs)>()));
+	};
+
+	template <>
+	struct sort<> {
+		using type = type_list<>;
+	};
+
+	template <typename... SSs>
+	struct sort<type_list<SSs...>> : sort<SSs...> {};
+
+
+	template <typename Char>
+	constexpr Char ascii_lower(Char c) {
+		return (c >= Char('A') && c <= Char('Z')) ? Char(c - Char('A') + Char('a')) : c;
+	}
+
+	template <typename Char>
+	constexpr Char ascii_upper(Char c) {
+		return (c >= Char('a') && c <= Char('z')) ? Char(c - Char('a') + Char('A')) : c;
+	}
+
+	template <typename SS>
+	struct to_lower;
+
+	template <typename Char, Char... chars>
+	struct to_lower<static_string<Char, chars...>> {
+		using type = static_string<Char, ascii_lower(chars)...>;
+	};
+
+	template <typename SS>
+	struct to_upper;
+
+	template <typename Char, Char... chars>
+	struct to_upper<static_string<Char, chars...>> {
+		using type = static_string<Char, ascii_upper(chars)...>;
+	};
+
+
+	template <typename Char>
+	constexpr Char digit(unsigned d) {
+		return Char(d < 10 ? '0' + d : 'a' + (d - 10));
+	}
+
+	template <typename Char, unsigned long long N, unsigned Base, size_t Width, bool Done, Char... chars>
+	struct from_digits {
+		using type = typename from_digits<Char,
+		                                  N / Base,
+		                                  Base,
+		                                  (Width > 1) ? Width - 1 : 0,
+		                                  (N / Base == 0 && Width <= 1),
+		                                  digit<Char>(N % Base),
+		                                  chars...
+		                                 >::type;
+	};
+
+	template <typename Char, unsigned long long N, unsigned Base, size_t Width, Char... chars>
+	struct from_digits<Char, N, Base, Width, true, chars...> {
+		using type = static_string<Char, chars...>;
+	};
+
+	template <typename Char, unsigned long long N, unsigned Base, size_t Width>
+	struct from_unsigned {
+		static_assert(Base >= 2 && Base <= 36, "base must be between 2 and 36");
+		using type = typename from_digits<Char, N, Base, Width, false>::type;
+	};
+
+	template <typename Char, long long N, unsigned Base, size_t Width, bool = (N < 0)>
+	struct from_integer {
+		using type = typename from_unsigned<Char, N, Base, Width>::type;
+	};
+
+	template <typename Char, long long N, unsigned Base, size_t Width>
+	struct from_integer<Char, N, Base, Width, true> {
+		using type = typename concat<static_string<Char, Char('-')>,
+		                             typename from_unsigned<Char, 0ULL - static_cast<unsigned long long>(N), Base, Width>::type
+		                            >::type;
+	};
+
+
+	template <typename SS, size_t Width, typename Char, Char Fill, bool Left, bool = (SS::size >= Width)>
+	struct pad {
+		using type = SS;
+	};
+
+	template <typename Char, Char... chars, size_t Width, Char Fill>
+	struct pad<static_string<Char, chars...>, Width, Char, Fill, true, false> {
+		using type = typename pad<static_string<Char, Fill, chars...>, Width, Char, Fill, true>::type;
 	};
 
-	template <size_t Pos, size_t Len, typename Char, Char c, Char... chars>
-	struct substring<Pos, Len, Char, c, chars...> {
-		using type = typename substring<Pos - 1, Len, Char, chars...>::type;
+	template <typename Char, Char... chars, size_t Width, Char Fill>
+	struct pad<static_string<Char, chars...>, Width, Char, Fill, false, false> {
+		using type = typename pad<static_string<Char, chars..., Fill>, Width, Char, Fill, false>::type;
 	};
 
 
@@ -238,6 +533,39 @@ using from_provider = typename __impl::build_from_provider<StrProvider,
 template <typename... SSs>
 using concat = typename __impl::concat<SSs...>::type;
 
+template <typename Sep, typename... SSs>
+using join = typename __impl::join<Sep, SSs...>::type;
+
+template <typename SS1, typename SS2>
+using compare = std::integral_constant<int, __impl::compare<SS1, SS2>::value>;
+
+template <typename SS1, typename SS2>
+using less = std::integral_constant<bool, (__impl::compare<SS1, SS2>::value < 0)>;
+
+template <typename SS1, typename SS2>
+using equal = std::integral_constant<bool, (__impl::compare<SS1, SS2>::value == 0)>;
+
+template <typename... SSs>
+using sort = typename __impl::sort<SSs...>::type;
+
+template <typename SS>
+using to_lower = typename __impl::to_lower<SS>::type;
+
+template <typename SS>
+using to_upper = typename __impl::to_upper<SS>::type;
+
+template <long long N, unsigned Base = 10, typename Char = char, size_t Width = 0>
+using from_integer = typename __impl::from_integer<Char, N, Base, Width>::type;
+
+template <unsigned long long N, unsigned Base = 10, typename Char = char, size_t Width = 0>
+using from_unsigned = typename __impl::from_unsigned<Char, N, Base, Width>::type;
+
+template <typename SS, size_t Width, typename SS::char_type Fill = ' '>
+using pad_left = typename __impl::pad<SS, Width, typename SS::char_type, Fill, true>::type;
+
+template <typename SS, size_t Width, typename SS::char_type Fill = ' '>
+using pad_right = typename __impl::pad<SS, Width, typename SS::char_type, Fill, false>::type;
+
 
 } /* namespace static_string */
 
@@ -1,6 +1,29 @@
 #include "static-strings.hpp"
+#include "compress.hpp"
+#include "csv.hpp"
+#include "digest.hpp"
+#include "enums.hpp"
+#include "format.hpp"
+#include "icase.hpp"
+#include "lookup.hpp"
+#include "pool.hpp"
+#include "regex.hpp"
+#include "searcher.hpp"
+#include "trie.hpp"
+#include "utf.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <regex>
+#include <stdexcept>
+#include <strings.h>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 
 void testBuildingWithIndividualChars() {
@@ -163,6 +186,803 @@ void testSubstring() {
 }
 
 
+void testFromInteger() {
+	assert((std::is_same<static_string::from_integer<0>, static_string::static_string<char, '0'>>::value));
+	assert((std::is_same<static_string::from_integer<-42>, static_string::static_string<char, '-', '4', '2'>>::value));
+	assert(static_string::from_integer<1234567890>::string() == "1234567890");
+	assert(static_string::from_integer<-9223372036854775807LL - 1>::string() == "-9223372036854775808");
+	assert(static_string::from_integer<9223372036854775807LL>::string() == "9223372036854775807");
+	assert(static_string::from_unsigned<18446744073709551615ULL>::string() == "18446744073709551615");
+	assert(static_string::from_unsigned<0>::string() == "0");
+
+	assert((static_string::from_integer<5, 2>::string() == "101"));
+	assert((static_string::from_integer<-255, 16>::string() == "-ff"));
+	assert((static_string::from_unsigned<18446744073709551615ULL, 16>::string() == "ffffffffffffffff"));
+	assert((static_string::from_integer<35, 36>::string() == "z"));
+	assert((static_string::from_integer<36, 36>::string() == "10"));
+	assert((static_string::from_integer<8, 8>::string() == "10"));
+
+	assert((static_string::from_integer<7, 10, char, 3>::string() == "007"));
+	assert((static_string::from_integer<-7, 10, char, 3>::string() == "-007"));
+	assert((static_string::from_integer<1234, 10, char, 3>::string() == "1234"));
+	assert((static_string::from_unsigned<0, 2, char, 8>::string() == "00000000"));
+
+	assert((static_string::from_integer<-10, 16,  wchar_t>::string() == L"-a"));
+	assert((static_string::from_integer<-10, 16, char16_t>::string() == u"-a"));
+	assert((static_string::from_integer<-10, 16, char32_t>::string() == U"-a"));
+
+	using Seven = static_string::from_integer<7>;
+	assert((static_string::pad_left<Seven, 4>::string() == "   7"));
+	assert((static_string::pad_right<Seven, 4, '.'>::string() == "7..."));
+	assert((static_string::pad_left<Seven, 1>::string() == "7"));
+	assert((static_string::pad_left<static_string::static_string<char32_t>, 2, U'*'>::string() == U"**"));
+
+	struct Shard { constexpr static const char* str() { return "shard_"; } };
+	using Shard42 = static_string::concat<static_string::from_provider<Shard>, static_string::from_integer<42>>;
+	assert(Shard42::string() == "shard_42");
+	assert((std::is_same<Shard42::substring<6, 2>, static_string::from_integer<42>>::value));
+}
+
+
+#define TEN_FIELDS "id,name,size,kind,owner,group,created,modified,checksum,flags,"
+#define HUNDRED_FIELDS TEN_FIELDS TEN_FIELDS TEN_FIELDS TEN_FIELDS TEN_FIELDS \
+                       TEN_FIELDS TEN_FIELDS TEN_FIELDS TEN_FIELDS TEN_FIELDS
+
+void testSplitAndJoin() {
+	using Empty = static_string::static_string<char>;
+	assert((std::is_same<Empty::split<','>, static_string::type_list<Empty>>::value));
+
+	struct Header { constexpr static const char* str() { return "id,name,,size"; } };
+	using Fields = static_string::from_provider<Header>::split<','>;
+	assert(Fields::size == 4);
+	assert(Fields::at<0>::string() == "id");
+	assert(Fields::at<1>::string() == "name");
+	assert(Fields::at<2>::string() == "");
+	assert(Fields::at<3>::string() == "size");
+
+	using Comma = static_string::static_string<char, ','>;
+	using Arrow = static_string::static_string<char, ' ', '-', '>', ' '>;
+	assert((std::is_same<static_string::join<Comma, Fields>, static_string::from_provider<Header>>::value));
+	assert((static_string::join<Arrow, Fields::at<0>, Fields::at<1>, Fields::at<3>>::string() == "id -> name -> size"));
+	assert((std::is_same<static_string::join<Comma>, Empty>::value));
+	assert((static_string::join<Empty, Fields>::string() == "idnamesize"));
+
+	using Wide = static_string::static_string<char32_t, U'a', U'/', U'b'>;
+	using WideParts = Wide::split<U'/'>;
+	assert(WideParts::size == 2);
+	assert(WideParts::at<1>::string() == U"b");
+	assert((std::is_same<static_string::join<static_string::static_string<char32_t, U'/'>, WideParts>, Wide>::value));
+
+	struct Many { constexpr static const char* str() { return HUNDRED_FIELDS HUNDRED_FIELDS HUNDRED_FIELDS "last"; } };
+	using Columns = static_string::from_provider<Many>::split<','>;
+	assert(Columns::size == 301);
+	assert(Columns::at<0>::string() == "id");
+	assert(Columns::at<299>::string() == "flags");
+	assert(Columns::at<300>::string() == "last");
+	assert((std::is_same<static_string::join<Comma, Columns>, static_string::from_provider<Many>>::value));
+}
+
+
+void testTrie() {
+	struct If       { constexpr static const char* str() { return "if"; } };
+	struct In       { constexpr static const char* str() { return "in"; } };
+	struct Int      { constexpr static const char* str() { return "int"; } };
+	struct Interval { constexpr static const char* str() { return "interval"; } };
+	struct Return   { constexpr static const char* str() { return "return"; } };
+
+	using Keywords = static_string::trie<static_string::from_provider<If>,
+	                                     static_string::from_provider<In>,
+	                                     static_string::from_provider<Int>,
+	                                     static_string::from_provider<Interval>,
+	                                     static_string::from_provider<Return>>;
+	assert(Keywords::size == 5);
+
+	assert(Keywords::match("if").index == 0);
+	assert(Keywords::match("in").index == 1);
+	assert(Keywords::match("int").index == 2);
+	assert(Keywords::match("interval").index == 3);
+	assert(Keywords::match("return").index == 4);
+	assert(Keywords::match("return").length == 6);
+	assert(!Keywords::match(""));
+	assert(!Keywords::match("i"));
+	assert(!Keywords::match("inter"));
+	assert(!Keywords::match("intervals"));
+	assert(!Keywords::match("returns"));
+	assert(!Keywords::match("retur"));
+	assert(!Keywords::match("retura"));
+
+	static_string::trie_match m = Keywords::longest_prefix("interval;");
+	assert(m.index == 3 && m.length == 8);
+	m = Keywords::longest_prefix("interv");
+	assert(m.index == 2 && m.length == 3);
+	m = Keywords::longest_prefix("inside");
+	assert(m.index == 1 && m.length == 2);
+	m = Keywords::longest_prefix("return0");
+	assert(m.index == 4 && m.length == 6);
+	assert(!Keywords::longest_prefix("retur"));
+	assert(!Keywords::longest_prefix("x"));
+
+	std::string matched;
+	auto handler = [&matched](auto key) { matched = decltype(key)::string(); };
+	assert(Keywords::dispatch("interval", handler));
+	assert(matched == "interval");
+	assert(!Keywords::dispatch("integer", handler));
+	assert(matched == "interval");
+
+	using Empty = static_string::static_string<char16_t>;
+	using Ab = static_string::static_string<char16_t, u'a', u'b'>;
+	using WithEmpty = static_string::trie<Ab, Empty>;
+	assert(WithEmpty::match(u"").index == 1);
+	assert(WithEmpty::match(u"ab").index == 0);
+	assert(WithEmpty::longest_prefix(u"a").index == 1);
+	assert(WithEmpty::longest_prefix(u"abc").length == 2);
+}
+
+
+void testSearcher() {
+	struct Needle { constexpr static const char* str() { return "needle"; } };
+	using Searcher = static_string::searcher<static_string::from_provider<Needle>>;
+
+	std::string haystack(100, '.');
+	assert(Searcher::find(haystack) == static_string::NOT_FOUND);
+	haystack += "needlneedlee";
+	assert(Searcher::find(haystack) == 105);
+	assert(Searcher::find(haystack, 106) == static_string::NOT_FOUND);
+	assert(Searcher::find("needle") == 0);
+	assert(Searcher::find("needl") == static_string::NOT_FOUND);
+	assert(Searcher::find("") == static_string::NOT_FOUND);
+
+	for(size_t pos = 0; pos < 80; pos++) {
+		std::string s = std::string(pos, 'n') + "needle" + std::string(80 - pos, 'e');
+		const char* first = s.data();
+		const char* last = s.data() + s.size();
+		assert(Searcher::search(first, last) == first + pos);
+		assert(Searcher::horspool(first, last) == first + pos);
+		assert(Searcher::kmp(first, last) == first + pos);
+	}
+
+	using Empty = static_string::searcher<static_string::static_string<char>>;
+	assert(Empty::find("abc") == 0);
+	assert(Empty::find("abc", 3) == 3);
+
+	using Aab = static_string::searcher<static_string::static_string<char32_t, U'a', U'a', U'b'>>;
+	std::u32string u = U"aaaaab";
+	assert(Aab::find(u) == 3);
+	assert(Aab::kmp(u.data(), u.data() + u.size()) == u.data() + 3);
+	assert(Aab::find(U"\u0161aab") == 1);
+	assert(Aab::find(U"aaa") == static_string::NOT_FOUND);
+}
+
+
+template <int Precision>
+void checkFixed(double value) {
+	using Format = static_string::formatter<static_string::static_string<char, '%', '.', char('0' + Precision), 'f'>>;
+	char expected[64];
+	char actual[64];
+	std::snprintf(expected, sizeof(expected), "%.*f", Precision, value);
+	Format::format(actual, sizeof(actual), value);
+	assert(std::strcmp(actual, expected) == 0);
+}
+
+void testFormatter() {
+	struct Line { constexpr static const char* str() { return "%s worker-%02d request %zu took %.3f ms (%x/%X/%o) %c%%"; } };
+	using Format = static_string::formatter<static_string::from_provider<Line>>;
+	assert(Format::arguments == 8);
+
+	char expected[128];
+	char buffer[128];
+	int n = std::snprintf(expected, sizeof(expected), Line::str(), "GET", 7, size_t(123456789), 1.5, 255, 255, 8, 'z');
+	assert(Format::format(buffer, sizeof(buffer), "GET", 7, size_t(123456789), 1.5, 255, 255, 8, 'z') == size_t(n));
+	assert(std::strcmp(buffer, expected) == 0);
+	assert(Format::string(std::string("PUT"), -7, 0ul, -0.0625, 0, 0, 0, '!') == "PUT worker--7 request 0 took -0.062 ms (0/0/0) !%");
+
+	struct Padding { constexpr static const char* str() { return "[%5d|%-5d|%05d|%-6s|%6s|%.2s|%8.2f|%-8.1f|%08.3f]"; } };
+	using Padded = static_string::formatter<static_string::from_provider<Padding>>;
+	n = std::snprintf(expected, sizeof(expected), Padding::str(), -42, 42, -42, "ab", "cd", "efgh", 3.14159, -2.75, -1.0);
+	assert(Padded::format(buffer, sizeof(buffer), -42, 42, -42, "ab", "cd", "efgh", 3.14159, -2.75, -1.0) == size_t(n));
+	assert(std::strcmp(buffer, expected) == 0);
+
+	struct Numbers { constexpr static const char* str() { return "%d %u %lld %f %.0f %.9f"; } };
+	using Numeric = static_string::formatter<static_string::from_provider<Numbers>>;
+	long long min = -9223372036854775807LL - 1;
+	n = std::snprintf(expected, sizeof(expected), Numbers::str(), -2147483647 - 1, 4294967295u, min, 1234567.890123, 2.75, 0.000000001);
+	assert(Numeric::format(buffer, sizeof(buffer), -2147483647 - 1, 4294967295u, min, 1234567.890123, 2.75, 0.000000001) == size_t(n));
+	assert(std::strcmp(buffer, expected) == 0);
+	n = std::snprintf(expected, sizeof(expected), Numbers::str(), 0, 0u, 0LL, 1e300, -1e20, 0.5);
+	assert(Numeric::format(buffer, sizeof(buffer), 0, 0u, 0LL, 1e300, -1e20, 0.5) == size_t(n));
+	assert(std::strcmp(buffer, expected) == 0);
+
+	assert(Format::format(buffer, 8, "GET", 7, size_t(1), 1.0, 1, 1, 1, 'a') == 48);
+	assert(std::strcmp(buffer, "GET wor") == 0);
+	assert(Format::format(nullptr, 0, "GET", 7, size_t(1), 1.0, 1, 1, 1, 'a') == 48);
+
+	struct Literal { constexpr static const char* str() { return "100%% literal"; } };
+	assert(static_string::formatter<static_string::from_provider<Literal>>::string() == "100% literal");
+	using Empty = static_string::formatter<static_string::static_string<char>>;
+	assert(Empty::string() == "");
+
+	struct Precision { constexpr static const char* str() { return "[%.3d|%05.2d|%-6.3d|%.0d|%.0x|%8.4X|%.10o|%-4.2d]"; } };
+	using Precise = static_string::formatter<static_string::from_provider<Precision>>;
+	assert(Precise::string(5, 7, -42, 0, 0u, 255u, 8u, 3) == "[005|   07|-042  |||    00FF|0000000010|03  ]");
+
+	struct Null { constexpr static const char* str() { return "[%s|%8s|%-7s|%.3s|%.6s|%5.2s]"; } };
+	const char* null = nullptr;
+	assert(static_string::formatter<static_string::from_provider<Null>>::string(null, null, null, null, null, null) == "[(null)|  (null)|(null) ||(null)|     ]");
+
+	// Ties go to the even last kept digit, and the exact decimal value of
+	// the double decides the others.
+	struct Rounding { constexpr static const char* str() { return "%.0f %.0f %.0f %.2f %.2f %.1f"; } };
+	assert(static_string::formatter<static_string::from_provider<Rounding>>::string(1.5, 2.5, 3.5, 0.445, 1.115, 0.25) == "2 2 4 0.45 1.11 0.2");
+
+	static void (*const fixed[])(double) = {
+		checkFixed<0>, checkFixed<1>, checkFixed<2>, checkFixed<3>, checkFixed<4>, checkFixed<5>, checkFixed<6>,
+	};
+	std::mt19937_64 random(28);
+	std::uniform_real_distribution<double> exponent(-6, 12);
+	for(int k = 0; k < 700000; k++) {
+		// Random magnitudes, and values of few decimals, which are ties or
+		// close to them.
+		double value = (k % 2) ? std::pow(10.0, exponent(random)) : double(random() % 1000000) / 1000;
+		fixed[k % 7]((random() % 2) ? -value : value);
+	}
+
+	//Format::string("GET", 7, size_t(1), "1.0", 1, 1, 1, 'a'); // SHOULD NOT COMPILE!
+	//Format::string("GET", 7); // SHOULD NOT COMPILE!
+	//Format::string("GET", 7, size_t(1), 1.0L, 1, 1, 1, 'a'); // SHOULD NOT COMPILE!
+}
+
+
+void testPool() {
+	struct Request  { constexpr static const char* str() { return "request"; } };
+	struct Quest    { constexpr static const char* str() { return "quest"; } };
+	struct Response { constexpr static const char* str() { return "response"; } };
+	struct Est      { constexpr static const char* str() { return "est"; } };
+	struct Other    { constexpr static const char* str() { return "request"; } };
+
+	using RequestSS = static_string::from_provider<Request>;
+	using QuestSS = static_string::from_provider<Quest>;
+	using ResponseSS = static_string::from_provider<Response>;
+	using EstSS = static_string::from_provider<Est>;
+	using OtherSS = static_string::from_provider<Other>;
+	using Empty = static_string::static_string<char>;
+
+	using Pool = static_string::pool<QuestSS, RequestSS, ResponseSS, EstSS, OtherSS, Empty>;
+	assert(Pool::count == 6);
+	assert(Pool::size == sizeof("request") + sizeof("response"));
+
+	constexpr Pool::handle request = Pool::handle_of<RequestSS>::value;
+	constexpr Pool::handle quest = Pool::handle_of<QuestSS>::value;
+	constexpr Pool::handle est = Pool::handle_of<EstSS>::value;
+	constexpr Pool::handle other = Pool::handle_of<OtherSS>::value;
+	constexpr Pool::handle response = Pool::handle_of<ResponseSS>::value;
+	constexpr Pool::handle empty = Pool::handle_of<Empty>::value;
+
+	assert(request == other);
+	assert(quest == request + 2);
+	assert(est == request + 4);
+	assert(request != response);
+	assert(std::string(Pool::c_str(request)) == "request");
+	assert(Pool::string(quest) == "quest");
+	assert(Pool::string(est) == "est");
+	assert(Pool::string(response) == "response");
+	assert(Pool::string(empty) == "");
+
+	assert(Pool::find("request") == request);
+	assert(Pool::find("quest") == quest);
+	assert(Pool::find("est") == est);
+	assert(Pool::find("response") == response);
+	assert(Pool::find("") == empty);
+	assert(Pool::find("requests") == Pool::NO_HANDLE);
+	assert(Pool::find("st") == Pool::NO_HANDLE);
+
+	using Wide = static_string::pool<static_string::static_string<char32_t, U'a', U'b'>, static_string::static_string<char32_t, U'b'>>;
+	assert(Wide::size == 3);
+	assert(Wide::find(U"b") == 1);
+}
+
+
+template <typename Regex>
+void checkRegexAgainstStd(const char* pattern, const std::vector<std::string>& inputs) {
+	std::regex expected(pattern);
+	for(const std::string& input : inputs) {
+		std::smatch std_results;
+		typename Regex::match_results results;
+
+		bool matched = std::regex_match(input, std_results, expected);
+		assert(Regex::match(input) == matched);
+		assert(Regex::match(input, results) == matched);
+		for(size_t g = 0; matched && g <= Regex::groups; g++) {
+			if(std_results[g].matched) {
+				assert(results[g].begin == size_t(std_results.position(g)));
+				assert(results[g].end == size_t(std_results.position(g) + std_results.length(g)));
+			} else {
+				assert(results[g].begin == static_string::NOT_FOUND);
+			}
+		}
+
+		bool found = std::regex_search(input, std_results, expected);
+		assert(Regex::search(input) == found);
+		assert(Regex::search(input, results) == found);
+		for(size_t g = 0; found && g <= Regex::groups; g++) {
+			if(std_results[g].matched) {
+				assert(results[g].begin == size_t(std_results.position(g)));
+				assert(results[g].end == size_t(std_results.position(g) + std_results.length(g)));
+			} else {
+				assert(results[g].begin == static_string::NOT_FOUND);
+			}
+		}
+	}
+}
+
+void testRegex() {
+	struct Email    { constexpr static const char* str() { return "([a-z0-9._]+)@([a-z]+)\\.(com|org)"; } };
+	struct Range    { constexpr static const char* str() { return "(\\d+)-(\\d+)?"; } };
+	struct Lazy     { constexpr static const char* str() { return "<(.*?)>(?:x|y)*"; } };
+	struct Classes  { constexpr static const char* str() { return "[^\\s,]+(,[\\w-]*)*\\.?"; } };
+	struct Nested   { constexpr static const char* str() { return "((a|b)+c)?d"; } };
+	struct Empty    { constexpr static const char* str() { return ""; } };
+	struct Brackets { constexpr static const char* str() { return "[\\]a]+[-x]"; } };
+
+	using EmailRegex = static_string::regex<static_string::from_provider<Email>>;
+	assert(EmailRegex::groups == 3);
+	assert(EmailRegex::match("john.doe@example.com"));
+	assert(!EmailRegex::match("john.doe@example.net"));
+	assert(EmailRegex::search("mail john@example.org now"));
+	EmailRegex::match_results results;
+	assert(EmailRegex::search("mail john@example.org now", results));
+	assert(results[0].begin == 5 && results[0].end == 21);
+	assert(results[1].begin == 5 && results[1].end == 9);
+	assert(results[3].begin == 18 && results[3].end == 21);
+
+	const std::vector<std::string> inputs = {
+		"", "a", "d", "abcd", "bacd", "cd", "abd", "12-34", "12-", "-34", "x 7-8 y", "<a>", "<a><b>xy", "<>",
+		"a,b,c", "a,b-c.", ", x", "x@y.com", "a.b_c@d.org!", "]]-", "a]-", "x<y>z", "1-2-3",
+	};
+	checkRegexAgainstStd<EmailRegex>(Email::str(), inputs);
+	checkRegexAgainstStd<static_string::regex<static_string::from_provider<Range>>>(Range::str(), inputs);
+	checkRegexAgainstStd<static_string::regex<static_string::from_provider<Lazy>>>(Lazy::str(), inputs);
+	checkRegexAgainstStd<static_string::regex<static_string::from_provider<Classes>>>(Classes::str(), inputs);
+	checkRegexAgainstStd<static_string::regex<static_string::from_provider<Nested>>>(Nested::str(), inputs);
+	checkRegexAgainstStd<static_string::regex<static_string::from_provider<Empty>>>(Empty::str(), inputs);
+	checkRegexAgainstStd<static_string::regex<static_string::from_provider<Brackets>>>(Brackets::str(), inputs);
+
+	struct Redundant { constexpr static const char* str() { return "(a|a)*b|(a|a)*c"; } };
+	using RedundantRegex = static_string::regex<static_string::from_provider<Redundant>>;
+	assert(RedundantRegex::match_states == 3);
+
+	//struct Invalid { constexpr static const char* str() { return "a(b"; } };
+	//(void)static_string::regex<static_string::from_provider<Invalid>>::groups; // SHOULD NOT COMPILE!
+}
+
+
+void testCsvParser() {
+	struct Header { constexpr static const char* str() { return "id,name,score"; } };
+	using Parser = static_string::csv_parser<static_string::from_provider<Header>,
+	                                         static_string::type_list<int, std::string, double>>;
+	assert(Parser::columns == 3);
+	assert(Parser::names::at<1>::string() == "name");
+
+	const std::string csv = "id,name,score\r\n1,alice,9.5\r\n-2,bob,-0.25\n3,,1e3\n4,a long name that spans simd blocks,12345678.125";
+	const char* first = csv.data();
+	const char* last = csv.data() + csv.size();
+
+	Parser::columns_type table;
+	const char* body = Parser::skip_header(first, last);
+	assert(Parser::parse(body, last, table, 2) == 4);
+	assert((std::get<0>(table) == std::vector<int>{1, -2, 3, 4}));
+	assert((std::get<1>(table) == std::vector<std::string>{"alice", "bob", "", "a long name that spans simd blocks"}));
+	assert((std::get<2>(table) == std::vector<double>{9.5, -0.25, 1000.0, 12345678.125}));
+
+	std::string many;
+	for(int i = 0; i < 1000; i++) {
+		many += std::to_string(i) + ",row" + std::to_string(i) + "," + std::to_string(i) + ".5\n";
+	}
+	for(unsigned threads : {1u, 2u, 3u, 8u}) {
+		Parser::columns_type parallel;
+		assert(Parser::parse_parallel(many.data(), many.data() + many.size(), parallel, threads) == 1000);
+		for(int i = 0; i < 1000; i++) {
+			assert(std::get<0>(parallel)[i] == i);
+			assert(std::get<1>(parallel)[i] == "row" + std::to_string(i));
+			assert(std::get<2>(parallel)[i] == i + 0.5);
+		}
+	}
+
+	auto errorLine = [](const std::string& input, unsigned threads) {
+		Parser::columns_type ignored;
+		try {
+			Parser::parse_parallel(input.data(), input.data() + input.size(), ignored, threads);
+		} catch(const static_string::csv_error& e) {
+			return e.line;
+		}
+		return size_t(0);
+	};
+	assert(errorLine("1,a,1\n2,b\n", 1) == 2);
+	assert(errorLine("1,a,1\n2,b,2,x\n", 1) == 2);
+	assert(errorLine("1,a,1\nx,b,2\n", 1) == 2);
+	assert(errorLine("1,a,1.5.\n", 1) == 1);
+	assert(errorLine(many + "1,a,b\n", 4) == 1001);
+	assert(errorLine(many, 4) == 0);
+
+	struct Ranges { constexpr static const char* str() { return "small,id"; } };
+	using Ranged = static_string::csv_parser<static_string::from_provider<Ranges>,
+	                                         static_string::type_list<std::uint8_t, int>>;
+	auto rangeError = [](const std::string& input) {
+		Ranged::columns_type ignored;
+		try {
+			Ranged::parse(input.data(), input.data() + input.size(), ignored);
+		} catch(const static_string::csv_error& e) {
+			return e.reason + " at " + std::to_string(e.line);
+		}
+		return std::string();
+	};
+	Ranged::columns_type limits;
+	const std::string extremes = "255,2147483647\n0,-2147483648\n";
+	assert(Ranged::parse(extremes.data(), extremes.data() + extremes.size(), limits) == 2);
+	assert((std::get<0>(limits) == std::vector<std::uint8_t>{255, 0}));
+	assert((std::get<1>(limits) == std::vector<int>{2147483647, -2147483647 - 1}));
+	assert(rangeError("1,1\n300,1\n") == "value out of range in column small at 2");
+	assert(rangeError("256,1\n") == "value out of range in column small at 1");
+	assert(rangeError("1,2147483648\n") == "value out of range in column id at 1");
+	assert(rangeError("1,-2147483649\n") == "value out of range in column id at 1");
+	assert(rangeError("1,1\n1,1\n1,12345678901234567890\n") == "value out of range in column id at 3");
+	assert(rangeError("-1,1\n") == "invalid value in column small at 1");
+
+	bool thrown = false;
+	try {
+		Parser::skip_header("id,name\n", "id,name\n" + 8);
+	} catch(const static_string::csv_error&) {
+		thrown = true;
+	}
+	assert(thrown);
+
+	struct TsvHeader { constexpr static const char* str() { return "key\tvalue"; } };
+	using Tsv = static_string::csv_parser<static_string::from_provider<TsvHeader>,
+	                                      static_string::type_list<std::string, unsigned long>,
+	                                      '\t'>;
+	const std::string tsv = "key\tvalue\nx,y\t18446744073709551615\n";
+	Tsv::columns_type pairs;
+	assert(Tsv::parse(Tsv::skip_header(tsv.data(), tsv.data() + tsv.size()), tsv.data() + tsv.size(), pairs) == 1);
+	assert(std::get<0>(pairs)[0] == "x,y");
+	assert(std::get<1>(pairs)[0] == 18446744073709551615ul);
+}
+
+
+void testTranscode() {
+	struct Utf8  { constexpr static const     char* str() { return "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80!"; } };
+	struct Utf16 { constexpr static const char16_t* str() { return u"café € \U0001F600!"; } };
+	struct Utf32 { constexpr static const char32_t* str() { return U"café € \U0001F600!"; } };
+
+	using S8  = static_string::from_provider<Utf8>;
+	using S16 = static_string::from_provider<Utf16>;
+	using S32 = static_string::from_provider<Utf32>;
+
+	assert((std::is_same<static_string::transcode<S8,  char16_t>, S16>::value));
+	assert((std::is_same<static_string::transcode<S8,  char32_t>, S32>::value));
+	assert((std::is_same<static_string::transcode<S16, char>,     S8>::value));
+	assert((std::is_same<static_string::transcode<S16, char32_t>, S32>::value));
+	assert((std::is_same<static_string::transcode<S32, char>,     S8>::value));
+	assert((std::is_same<static_string::transcode<S32, char16_t>, S16>::value));
+	assert((std::is_same<static_string::transcode<S8,  char>,     S8>::value));
+	assert((static_string::transcode<S32, wchar_t>::string() == L"café € \U0001F600!"));
+	assert((static_string::transcode<static_string::static_string<char>, char32_t>::size == 0));
+
+	//struct Overlong { constexpr static const char* str() { return "\xC0\xAF"; } };
+	//(void)static_string::transcode<static_string::from_provider<Overlong>, char32_t>::size; // SHOULD NOT COMPILE!
+	//struct Unpaired { constexpr static const char16_t* str() { return u"\xD800x"; } };
+	//(void)static_string::transcode<static_string::from_provider<Unpaired>, char>::size; // SHOULD NOT COMPILE!
+
+	std::string ascii(100, 'x');
+	std::string mixed = ascii + S8::string() + ascii + S8::string();
+	std::u16string mixed16 = std::u16string(ascii.begin(), ascii.end()) + S16::string() + std::u16string(ascii.begin(), ascii.end()) + S16::string();
+	std::u32string mixed32 = std::u32string(ascii.begin(), ascii.end()) + S32::string() + std::u32string(ascii.begin(), ascii.end()) + S32::string();
+	assert(static_string::utf::transcode<char16_t>(mixed) == mixed16);
+	assert(static_string::utf::transcode<char32_t>(mixed) == mixed32);
+	assert(static_string::utf::transcode<char>(mixed16) == mixed);
+	assert(static_string::utf::transcode<char32_t>(mixed16) == mixed32);
+	assert(static_string::utf::transcode<char>(mixed32) == mixed);
+	assert(static_string::utf::transcode<char16_t>(mixed32) == mixed16);
+
+	const char* invalid[] = { "\x80", "\xC3", "\xC0\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xF8\x88\x80\x80\x80" };
+	for(const char* bad : invalid) {
+		std::string input = ascii + bad + "y";
+		char32_t out[256];
+		static_string::utf::result r = static_string::utf::transcode(input.data(), input.size(), out);
+		assert(!r.ok && r.read == ascii.size() && r.written == ascii.size());
+	}
+	bool thrown = false;
+	try {
+		static_string::utf::transcode<char>(std::u16string(1, char16_t(0xDC00)));
+	} catch(const std::range_error&) {
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+
+void testCompareAndSort() {
+	struct Apple  { constexpr static const char* str() { return "apple"; } };
+	struct App    { constexpr static const char* str() { return "app"; } };
+	struct Banana { constexpr static const char* str() { return "banana"; } };
+	struct Accent { constexpr static const char* str() { return "\xC3\xA9t\xC3\xA9"; } };
+
+	using A  = static_string::from_provider<Apple>;
+	using AP = static_string::from_provider<App>;
+	using B  = static_string::from_provider<Banana>;
+	using E  = static_string::from_provider<Accent>;
+	using Empty = static_string::static_string<char>;
+
+	static_assert(static_string::compare<A, B>::value < 0, "");
+	static_assert(static_string::compare<B, A>::value > 0, "");
+	static_assert(static_string::compare<A, A>::value == 0, "");
+	static_assert(static_string::less<AP, A>::value, "");
+	static_assert(!static_string::less<A, AP>::value, "");
+	static_assert(static_string::less<Empty, AP>::value, "");
+	static_assert(static_string::less<B, E>::value, "");
+	static_assert(static_string::equal<A, static_string::concat<AP, static_string::static_string<char, 'l', 'e'>>>::value, "");
+	static_assert(!static_string::equal<A, B>::value, "");
+
+	assert((std::is_same<static_string::sort<E, B, A, Empty, AP, A>,
+	                     static_string::type_list<Empty, AP, A, A, B, E>>::value));
+	assert((std::is_same<static_string::sort<static_string::type_list<B, A>>, static_string::type_list<A, B>>::value));
+	assert((std::is_same<static_string::sort<>, static_string::type_list<>>::value));
+
+	enum token { APPLE, APP, BANANA, ACCENT };
+	using Table = static_string::lookup_table<static_string::entry<A,  token, APPLE>,
+	                                          static_string::entry<AP, token, APP>,
+	                                          static_string::entry<E,  token, ACCENT>,
+	                                          static_string::entry<B,  token, BANANA>>;
+	static_assert(Table::size == 4, "");
+	static_assert(Table::keys[0].size == 3 && Table::values[0] == APP, "");
+	static_assert(Table::values[3] == ACCENT, "");
+	assert(Table::keys[1].string() == "apple");
+	assert(*Table::find("apple", 5) == APPLE);
+	assert(*Table::find(std::string("app")) == APP);
+	assert(*Table::find(E::string()) == ACCENT);
+	assert(Table::find("ap", 2) == nullptr);
+	assert(Table::find("apples", 6) == nullptr);
+	assert(Table::find("", 0) == nullptr);
+	assert(Table::find("zzz", 3) == nullptr);
+	assert(Table::index("banana", 6) == 2);
+
+	#define WORD(NAME, STR) struct NAME { constexpr static const char* str() { return STR; } }
+	WORD(W0, "for"); WORD(W1, "while"); WORD(W2, "do"); WORD(W3, "if"); WORD(W4, "else");
+	WORD(W5, "switch"); WORD(W6, "case"); WORD(W7, "default"); WORD(W8, "break"); WORD(W9, "return");
+	#undef WORD
+	using F = static_string::lookup_table<
+		static_string::entry<static_string::from_provider<W0>, int, 0>, static_string::entry<static_string::from_provider<W1>, int, 1>,
+		static_string::entry<static_string::from_provider<W2>, int, 2>, static_string::entry<static_string::from_provider<W3>, int, 3>,
+		static_string::entry<static_string::from_provider<W4>, int, 4>, static_string::entry<static_string::from_provider<W5>, int, 5>,
+		static_string::entry<static_string::from_provider<W6>, int, 6>, static_string::entry<static_string::from_provider<W7>, int, 7>,
+		static_string::entry<static_string::from_provider<W8>, int, 8>, static_string::entry<static_string::from_provider<W9>, int, 9>>;
+	const char* words[] = { W0::str(), W1::str(), W2::str(), W3::str(), W4::str(), W5::str(), W6::str(), W7::str(), W8::str(), W9::str() };
+	for(int i = 0; i < 10; i++) {
+		assert(*F::find(words[i], std::strlen(words[i])) == i);
+		assert(F::find(std::string(words[i]) + "x") == nullptr);
+		assert(F::find(words[i], std::strlen(words[i]) - 1) == nullptr);
+	}
+	assert(std::is_sorted(F::keys, F::keys + F::size, [](const static_string::view<char>& a, const static_string::view<char>& b) {
+		return a.string() < b.string();
+	}));
+}
+
+
+void testDigests() {
+	struct Check { constexpr static const char* str() { return "123456789"; } };
+	struct Abc   { constexpr static const char* str() { return "abc"; } };
+	struct Two   { constexpr static const char* str() { return "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"; } };
+
+	static_assert(static_string::crc32c<static_string::from_provider<Check>>::value == 0xE3069283, "");
+	static_assert(static_string::crc32c<Check>::value == 0xE3069283, "");
+	static_assert(static_string::crc32c<static_string::static_string<char>>::value == 0, "");
+	static_assert(static_string::sha256<Abc>::value.bytes[0] == 0xba && static_string::sha256<Abc>::value.bytes[31] == 0xad, "");
+
+	assert(static_string::sha256<static_string::from_provider<Abc>>::value.hex()
+	       == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+	assert(static_string::sha256<Two>::value.hex()
+	       == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+	assert(static_string::sha256<static_string::static_string<char>>::value.hex()
+	       == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+	assert(static_string::digest::crc32c(Check::str(), 9) == static_string::crc32c<Check>::value);
+	assert(static_string::digest::sha256(Two::str(), std::strlen(Two::str())) == static_string::sha256<Two>::value);
+
+	struct Wide { constexpr static const char16_t* str() { return u"été"; } };
+	const char16_t* wide = Wide::str();
+	assert(static_string::digest::crc32c(wide, 6) == static_string::crc32c<Wide>::value);
+	assert(static_string::digest::sha256(wide, 6) == static_string::sha256<Wide>::value);
+
+	std::mt19937 random(42);
+	std::vector<unsigned char> bytes(1000);
+	for(unsigned char& b : bytes) {
+		b = static_cast<unsigned char>(random());
+	}
+	for(size_t n = 0; n <= bytes.size(); n += (n < 200 ? 1 : 37)) {
+		for(size_t offset : {0, 1, 3}) {
+			if(offset + n > bytes.size()) {
+				continue;
+			}
+			const unsigned char* p = bytes.data() + offset;
+			assert(static_string::digest::crc32c(p, n) == static_string::digest::crc32c_scalar(p, n));
+			assert(static_string::digest::sha256(p, n) == static_string::digest::sha256_scalar(p, n));
+		}
+	}
+	uint32_t split = static_string::digest::crc32c(bytes.data(), 100);
+	assert(static_string::digest::crc32c(bytes.data() + 100, 900, split) == static_string::digest::crc32c(bytes.data(), 1000));
+	assert(static_string::digest::crc32c_scalar(bytes.data() + 100, 900, split) == static_string::digest::crc32c(bytes.data(), 1000));
+}
+
+
+void testCompressed() {
+	struct Text { constexpr static const char* str() {
+		return "Usage: tool [options] <file>...\n"
+		       "  --input <file>    read input from <file>\n"
+		       "  --output <file>   write output to <file>\n"
+		       "  --verbose         print more details\n"
+		       "  --quiet           print fewer details\n"
+		       "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		       "abcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabc!";
+	} };
+	using Compressed = static_string::compressed<Text>;
+	const std::string text = Text::str();
+
+	assert(size_t(Compressed::size) == text.size());
+	assert(Compressed::compressed_size < Compressed::size / 2);
+	assert(Compressed::string() == text);
+	assert(Compressed::c_str() == Compressed::c_str());
+	assert(Compressed::c_str() == text);
+
+	for(size_t chunk : {1, 3, 16, 255, 4096}) {
+		Compressed::stream stream;
+		std::string decoded;
+		std::vector<char> buffer(chunk);
+		while(!stream.done()) {
+			size_t n = stream.read(buffer.data(), buffer.size());
+			assert(n > 0 && n <= chunk);
+			decoded.append(buffer.data(), n);
+		}
+		assert(decoded == text);
+		assert(stream.read(buffer.data(), buffer.size()) == 0);
+	}
+
+	using Short = static_string::compressed<static_string::static_string<char, 'a', 'b', 'c'>>;
+	assert(Short::string() == "abc");
+	assert(Short::compressed_size == 4);
+
+	using Empty = static_string::compressed<static_string::static_string<char>>;
+	assert(Empty::size == 0 && Empty::compressed_size == 1);
+	assert(Empty::string().empty());
+	assert(Empty::stream().done());
+
+	struct Long { constexpr static const char* str() { return HUNDRED_FIELDS HUNDRED_FIELDS HUNDRED_FIELDS "last"; } };
+	using LongCompressed = static_string::compressed<Long>;
+	assert(LongCompressed::string() == Long::str());
+	assert(LongCompressed::compressed_size < LongCompressed::size / 4);
+}
+
+
+void testEnumNames() {
+	enum class level : int { trace = -1, debug, info, warn, error = 4, fatal };
+	struct Trace { constexpr static const char* str() { return "trace"; } };
+	struct Debug { constexpr static const char* str() { return "debug"; } };
+	struct Info  { constexpr static const char* str() { return "info"; } };
+	struct Warn  { constexpr static const char* str() { return "warn"; } };
+	struct Warning { constexpr static const char* str() { return "warning"; } };
+	struct Error { constexpr static const char* str() { return "error"; } };
+	struct Fatal { constexpr static const char* str() { return "fatal"; } };
+
+	using Levels = static_string::enum_names<level,
+		static_string::enumerator<level, level::trace, static_string::from_provider<Trace>>,
+		static_string::enumerator<level, level::debug, static_string::from_provider<Debug>>,
+		static_string::enumerator<level, level::info,  static_string::from_provider<Info>>,
+		static_string::enumerator<level, level::warn,  static_string::from_provider<Warn>>,
+		static_string::enumerator<level, level::warn,  static_string::from_provider<Warning>>,
+		static_string::enumerator<level, level::error, static_string::from_provider<Error>>,
+		static_string::enumerator<level, level::fatal, static_string::from_provider<Fatal>>>;
+
+	static_assert(Levels::size == 7, "");
+	static_assert(Levels::name(level::info).size == 4, "");
+	static_assert(Levels::name(level(3)).size == 0, "");
+	assert(Levels::name(level::trace).string() == "trace");
+	assert(Levels::name(level::warn).string() == "warn");
+	assert(Levels::name(level::fatal).string() == "fatal");
+	assert(Levels::name(level(3)).string() == "");
+	assert(Levels::name(level(42)).string() == "");
+	assert(Levels::name(level(-7)).data != nullptr);
+
+	level l = level::info;
+	assert(Levels::parse("error", 5, l) && l == level::error);
+	assert(Levels::parse(std::string("warning"), l) && l == level::warn);
+	assert(Levels::parse("trace", 5, l) && l == level::trace);
+	assert(!Levels::parse("war", 3, l) && l == level::trace);
+	assert(!Levels::parse("errors", 6, l));
+	assert(!Levels::parse("", 0, l));
+	assert(Levels::values[6] == level::fatal);
+
+	// Values on both sides of LLONG_MAX, and the extremes of signed types.
+	enum class flag : std::uint64_t { low = 0x7FFFFFFFFFFFFFFEull, mid, high = 0x8000000000000001ull };
+	using Flags = static_string::enum_names<flag,
+		static_string::enumerator<flag, flag::low,  static_string::from_provider<Debug>>,
+		static_string::enumerator<flag, flag::high, static_string::from_provider<Fatal>>>;
+	static_assert(Flags::name(flag::high).size == 5 && Flags::name(flag::mid).size == 0, "");
+	assert(Flags::name(flag::low).string() == "debug" && Flags::name(flag::high).string() == "fatal");
+	assert(Flags::name(flag(0)).string() == "" && Flags::name(flag(0x7FFFFFFFFFFFFFFFull)).string() == "");
+	flag f = flag::low;
+	assert(Flags::parse("fatal", 5, f) && f == flag::high);
+
+	enum small : signed char { bottom = -128, top = -127 };
+	using Smalls = static_string::enum_names<small,
+		static_string::enumerator<small, bottom, static_string::from_provider<Trace>>,
+		static_string::enumerator<small, top,    static_string::from_provider<Info>>>;
+	assert(Smalls::name(bottom).string() == "trace" && Smalls::name(top).string() == "info");
+	assert(Smalls::name(small(127)).string() == "");
+
+	//enum sparse { a = 0, b = 1000 };
+	//using Sparse = static_string::enum_names<sparse, static_string::enumerator<sparse, a, static_string::from_provider<Info>>,
+	//                                                 static_string::enumerator<sparse, b, static_string::from_provider<Warn>>>;
+	//(void)Sparse::name(a); // SHOULD NOT COMPILE!
+}
+
+
+void testCaseFolding() {
+	struct Header { constexpr static const char* str() { return "Content-Type: \xC3\x89t\xC3\xA9 [@`{]"; } };
+	struct Wide   { constexpr static const char32_t* str() { return U"CafÉ"; } };
+	using H = static_string::from_provider<Header>;
+
+	assert(static_string::to_lower<H>::string() == "content-type: \xC3\x89t\xC3\xA9 [@`{]");
+	assert(static_string::to_upper<H>::string() == "CONTENT-TYPE: \xC3\x89T\xC3\xA9 [@`{]");
+	assert(static_string::to_lower<static_string::from_provider<Wide>>::string() == U"cafÉ");
+	assert((std::is_same<static_string::to_lower<static_string::static_string<char>>, static_string::static_string<char>>::value));
+
+	using static_string::icase::equal;
+	using static_string::icase::compare;
+	using static_string::icase::hash;
+
+	assert(equal<H>("CONTENT-type: \xC3\x89T\xC3\xA9 [@`{]", H::size));
+	assert(!equal<H>("CONTENT-type: \xC3\xA9T\xC3\xA9 [@`{]", H::size));
+	assert(!equal<H>("content-type: \xC3\x89t\xC3\xA9 [@`{", H::size - 1));
+	assert(!equal<H>(std::string("content-type: \xC3\x89t\xC3\xA9 [@`{]!")));
+	assert(equal(std::string("x-Forwarded-FOR"), std::string("X-forwarded-for")));
+	assert(!equal(std::string("@"), std::string("`")));
+	assert(!equal(std::string("["), std::string("{")));
+
+	std::mt19937 random(42);
+	const char alphabet[] = "aAzZ@[`{09-\x80\xC3\xE9\xFF";
+	for(int round = 0; round < 2000; round++) {
+		std::string a;
+		std::string b;
+		size_t n = random() % 40;
+		for(size_t i = 0; i < n; i++) {
+			a += alphabet[random() % (sizeof(alphabet) - 1)];
+			b += (random() % 4 == 0) ? alphabet[random() % (sizeof(alphabet) - 1)] : a.back();
+		}
+		if(random() % 3 == 0) {
+			b.resize(random() % (n + 1));
+		}
+		for(size_t i = 0; i < b.size(); i++) {
+			if(random() % 2 == 0) {
+				b[i] = std::toupper(static_cast<unsigned char>(b[i]));
+			}
+		}
+		int expected = ::strncasecmp(a.c_str(), b.c_str(), std::max(a.size(), b.size()) + 1);
+		int actual = compare(a, b);
+		assert((expected < 0) == (actual < 0) && (expected > 0) == (actual > 0));
+		assert(equal(a, b) == (expected == 0));
+		if(expected == 0) {
+			assert(hash(a) == hash(b));
+		}
+	}
+
+	static_assert(static_string::icase::hash_of<H>::value == static_string::icase::hash_of<static_string::to_upper<H>>::value, "");
+	assert(static_string::icase::hash_of<H>::value == hash(H::string()));
+	assert(hash("Accept", 6) == hash("aCCEPT", 6));
+	assert(hash("Accept", 6) != hash("Accept-", 7));
+
+	std::unordered_map<std::string, int, static_string::icase::hasher, static_string::icase::equal_to> headers;
+	headers["Content-Length"] = 42;
+	assert(headers.count("content-length") == 1 && headers["CONTENT-LENGTH"] == 42);
+}
+
+
 int main() {
 	testBuildingWithIndividualChars();
 	testBuildingWithStringProviders();
@@ -173,4 +993,18 @@ int main() {
 	testFind();
 	testRFind();
 	testSubstring();
+	testFromInteger();
+	testSplitAndJoin();
+	testTrie();
+	testSearcher();
+	testFormatter();
+	testPool();
+	testRegex();
+	testCsvParser();
+	testTranscode();
+	testCompareAndSort();
+	testDigests();
+	testCompressed();
+	testEnumNames();
+	testCaseFolding();
 }
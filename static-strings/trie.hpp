@@ -0,0 +1,288 @@
+#ifndef STATIC_STRINGS_TRIE_HPP_
+#define STATIC_STRINGS_TRIE_HPP_
+
+#include "static-strings.hpp"
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+
+namespace static_string {
+
+
+struct trie_match {
+	size_t index;
+	size_t length;
+
+	explicit operator bool() const {
+		return index != NOT_FOUND;
+	}
+};
+
+
+namespace __impl {
+namespace trie {
+
+
+	template <typename T, size_t N>
+	struct array {
+		T values[N ? N : 1];
+		size_t count;
+	};
+
+
+	template <typename Char>
+	inline bool equal_words(const Char* a, const Char* b, size_t n) {
+		const char* x = reinterpret_cast<const char*>(a);
+		const char* y = reinterpret_cast<const char*>(b);
+		size_t bytes = n * sizeof(Char);
+		for(; bytes >= 8; x += 8, y += 8, bytes -= 8) {
+			std::uint64_t u, v;
+			std::memcpy(&u, x, 8);
+			std::memcpy(&v, y, 8);
+			if(u != v) {
+				return false;
+			}
+		}
+		return std::memcmp(x, y, bytes) == 0;
+	}
+
+
+	template <typename Char, typename... Keys>
+	struct table {
+		using char_type = Char;
+
+		enum { count = sizeof...(Keys) };
+
+		static constexpr size_t size(size_t key) {
+			constexpr size_t sizes[] = { size_t(Keys::size)..., 0 };
+			return sizes[key];
+		}
+
+		static constexpr Char char_at(size_t key, size_t pos) {
+			constexpr const Char* datas[] = { Keys::data..., nullptr };
+			return datas[key][pos];
+		}
+
+		static const Char* data(size_t key) {
+			static constexpr const Char* datas[] = { Keys::data..., nullptr };
+			return datas[key];
+		}
+	};
+
+
+	template <size_t Depth, typename Table, size_t... Keys>
+	struct node_info {
+		using Char = typename Table::char_type;
+
+		enum { count = sizeof...(Keys) };
+
+		static constexpr size_t key(size_t i) {
+			constexpr size_t keys[] = { Keys..., 0 };
+			return keys[i];
+		}
+
+		static constexpr size_t accepted() {
+			for(size_t i = 0; i < count; i++) {
+				if(Table::size(key(i)) == Depth) {
+					return key(i);
+				}
+			}
+			return NOT_FOUND;
+		}
+
+		static constexpr bool tail() {
+			return count == 1 && Table::size(key(0)) > Depth;
+		}
+
+		static constexpr array<Char, count> branches() {
+			array<Char, count> result{};
+			for(size_t i = 0; i < count; i++) {
+				if(Table::size(key(i)) > Depth) {
+					Char c = Table::char_at(key(i), Depth);
+					bool seen = false;
+					for(size_t j = 0; j < result.count; j++) {
+						seen = seen || result.values[j] == c;
+					}
+					if(!seen) {
+						result.values[result.count++] = c;
+					}
+				}
+			}
+			return result;
+		}
+
+		static constexpr array<size_t, count> children(Char c) {
+			array<size_t, count> result{};
+			for(size_t i = 0; i < count; i++) {
+				if(Table::size(key(i)) > Depth && Table::char_at(key(i), Depth) == c) {
+					result.values[result.count++] = key(i);
+				}
+			}
+			return result;
+		}
+	};
+
+
+	template <typename Char, Char...>
+	struct chars {};
+
+
+	template <typename Info, typename Seq>
+	struct branch_chars;
+
+	template <typename Info, size_t... J>
+	struct branch_chars<Info, std::index_sequence<J...>> {
+		static constexpr auto branches = Info::branches();
+		using type = chars<typename Info::Char, branches.values[J]...>;
+	};
+
+
+	template <size_t Depth, typename Table, typename Keys>
+	struct node;
+
+	template <size_t Depth, typename Table, typename Info, typename Info::Char c, typename Seq>
+	struct child_of;
+
+	template <size_t Depth, typename Table, typename Info, typename Info::Char c, size_t... J>
+	struct child_of<Depth, Table, Info, c, std::index_sequence<J...>> {
+		static constexpr auto children = Info::children(c);
+		using type = node<Depth + 1, Table, std::index_sequence<children.values[J]...>>;
+	};
+
+
+	template <size_t Depth, typename Table, size_t... Keys>
+	struct node<Depth, Table, std::index_sequence<Keys...>> {
+	private:
+		using Info = node_info<Depth, Table, Keys...>;
+		using Char = typename Info::Char;
+
+		static constexpr size_t accepted = Info::accepted();
+
+		template <Char c>
+		using child = typename child_of<Depth, Table, Info, c,
+		                                std::make_index_sequence<Info::children(c).count>
+		                               >::type;
+
+		using branches = typename branch_chars<Info, std::make_index_sequence<Info::branches().count>>::type;
+
+		template <bool Prefix>
+		static trie_match branch(const Char* s, size_t len, trie_match best, chars<Char>) {
+			return Prefix ? best : trie_match{NOT_FOUND, 0};
+		}
+
+		template <bool Prefix, Char b, Char... bs>
+		static trie_match branch(const Char* s, size_t len, trie_match best, chars<Char, b, bs...>) {
+			if(s[Depth] == b) {
+				return child<b>::template walk<Prefix>(s, len, best);
+			}
+			return branch<Prefix>(s, len, best, chars<Char, bs...>());
+		}
+
+		template <bool Prefix>
+		static trie_match walk(const Char* s, size_t len, trie_match best, std::true_type) {
+			constexpr size_t key = Info::key(0);
+			constexpr size_t size = Table::size(key);
+			bool matches = Prefix ? len >= size : len == size;
+			if(matches && equal_words(s + Depth, Table::data(key) + Depth, size - Depth)) {
+				return {key, size};
+			}
+			return Prefix ? best : trie_match{NOT_FOUND, 0};
+		}
+
+		template <bool Prefix>
+		static trie_match walk(const Char* s, size_t len, trie_match best, std::false_type) {
+			if(accepted != NOT_FOUND) {
+				best = {accepted, Depth};
+			}
+			if(len == Depth) {
+				return Prefix || accepted != NOT_FOUND ? best : trie_match{NOT_FOUND, 0};
+			}
+			return branch<Prefix>(s, len, best, branches());
+		}
+
+	public:
+		template <bool Prefix>
+		static trie_match walk(const Char* s, size_t len, trie_match best) {
+			return walk<Prefix>(s, len, best, std::integral_constant<bool, Info::tail()>());
+		}
+	};
+
+
+	template <typename F, typename... Keys>
+	struct visitor;
+
+	template <typename F>
+	struct visitor<F> {
+		static bool visit(size_t index, size_t current, F&) {
+			return false;
+		}
+	};
+
+	template <typename F, typename Key, typename... Keys>
+	struct visitor<F, Key, Keys...> {
+		static bool visit(size_t index, size_t current, F& f) {
+			if(index == current) {
+				f(Key());
+				return true;
+			}
+			return visitor<F, Keys...>::visit(index, current + 1, f);
+		}
+	};
+
+
+} /* namespace trie */
+} /* namespace __impl */
+
+
+template <typename Key, typename... Keys>
+struct trie {
+	using char_type = typename Key::char_type;
+	using Char = char_type;
+	using string_type = std::basic_string<Char>;
+
+	enum { size = 1 + sizeof...(Keys) };
+
+	static trie_match match(const Char* s, size_t len) {
+		return root::template walk<false>(s, len, {NOT_FOUND, 0});
+	}
+
+	static trie_match match(const string_type& s) {
+		return match(s.data(), s.size());
+	}
+
+	static trie_match longest_prefix(const Char* s, size_t len) {
+		return root::template walk<true>(s, len, {NOT_FOUND, 0});
+	}
+
+	static trie_match longest_prefix(const string_type& s) {
+		return longest_prefix(s.data(), s.size());
+	}
+
+	template <typename F>
+	static bool dispatch(const Char* s, size_t len, F&& f) {
+		return visit(match(s, len).index, f);
+	}
+
+	template <typename F>
+	static bool dispatch(const string_type& s, F&& f) {
+		return dispatch(s.data(), s.size(), f);
+	}
+
+	template <typename F>
+	static bool visit(size_t index, F&& f) {
+		return __impl::trie::visitor<F, Key, Keys...>::visit(index, 0, f);
+	}
+
+private:
+	using root = __impl::trie::node<0,
+	                                __impl::trie::table<Char, Key, Keys...>,
+	                                std::make_index_sequence<size>
+	                               >;
+};
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_TRIE_HPP_ */
@@ -0,0 +1,333 @@
+#ifndef STATIC_STRINGS_UTF_HPP_
+#define STATIC_STRINGS_UTF_HPP_
+
+#include "static-strings.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace static_string {
+
+
+namespace __impl {
+namespace utf {
+
+
+	constexpr unsigned char SEQUENCE_LENGTH[256] = {
+		1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+		1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+		1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+		1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+		0,0,2,2,2,2,2,2,2,2,2,2,2,2,2,2, 2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,
+		3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3, 4,4,4,4,4,0,0,0,0,0,0,0,0,0,0,0,
+	};
+
+	constexpr char32_t MINIMUM[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+
+	struct decoded {
+		char32_t code_point;
+		size_t length;
+	};
+
+	constexpr bool is_scalar(char32_t cp) {
+		return cp < 0x110000 && (cp < 0xD800 || cp > 0xDFFF);
+	}
+
+	template <size_t Size>
+	struct codec;
+
+	template <>
+	struct codec<1> {
+		template <typename Char>
+		static constexpr decoded decode(const Char* s, size_t n) {
+			unsigned char lead = static_cast<unsigned char>(s[0]);
+			size_t length = SEQUENCE_LENGTH[lead];
+			if(length == 0 || length > n) {
+				return {0, 0};
+			}
+			char32_t cp = (length == 1) ? lead : (lead & (0x7F >> length));
+			for(size_t i = 1; i < length; i++) {
+				unsigned char b = static_cast<unsigned char>(s[i]);
+				if((b & 0xC0) != 0x80) {
+					return {0, 0};
+				}
+				cp = (cp << 6) | (b & 0x3F);
+			}
+			if(cp < MINIMUM[length] || !is_scalar(cp)) {
+				return {0, 0};
+			}
+			return {cp, length};
+		}
+
+		static constexpr size_t length(char32_t cp) {
+			return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+		}
+
+		template <typename Char>
+		static constexpr size_t encode(char32_t cp, Char* out) {
+			size_t n = length(cp);
+			if(n == 1) {
+				out[0] = Char(cp);
+				return 1;
+			}
+			const unsigned char LEAD[] = { 0, 0, 0xC0, 0xE0, 0xF0 };
+			for(size_t i = n - 1; i > 0; i--) {
+				out[i] = Char(0x80 | (cp & 0x3F));
+				cp >>= 6;
+			}
+			out[0] = Char(LEAD[n] | cp);
+			return n;
+		}
+	};
+
+	template <>
+	struct codec<2> {
+		template <typename Char>
+		static constexpr decoded decode(const Char* s, size_t n) {
+			char32_t high = static_cast<char16_t>(s[0]);
+			if(high < 0xD800 || high > 0xDFFF) {
+				return {high, 1};
+			}
+			if(high > 0xDBFF || n < 2) {
+				return {0, 0};
+			}
+			char32_t low = static_cast<char16_t>(s[1]);
+			if(low < 0xDC00 || low > 0xDFFF) {
+				return {0, 0};
+			}
+			return {0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00), 2};
+		}
+
+		static constexpr size_t length(char32_t cp) {
+			return cp < 0x10000 ? 1 : 2;
+		}
+
+		template <typename Char>
+		static constexpr size_t encode(char32_t cp, Char* out) {
+			if(cp < 0x10000) {
+				out[0] = Char(cp);
+				return 1;
+			}
+			cp -= 0x10000;
+			out[0] = Char(0xD800 + (cp >> 10));
+			out[1] = Char(0xDC00 + (cp & 0x3FF));
+			return 2;
+		}
+	};
+
+	template <>
+	struct codec<4> {
+		template <typename Char>
+		static constexpr decoded decode(const Char* s, size_t n) {
+			char32_t cp = static_cast<char32_t>(s[0]);
+			return is_scalar(cp) ? decoded{cp, 1} : decoded{0, 0};
+		}
+
+		static constexpr size_t length(char32_t cp) {
+			return 1;
+		}
+
+		template <typename Char>
+		static constexpr size_t encode(char32_t cp, Char* out) {
+			out[0] = Char(cp);
+			return 1;
+		}
+	};
+
+
+	template <typename Char, size_t N>
+	struct units {
+		Char values[N ? N : 1];
+	};
+
+	template <typename SS, typename To>
+	struct transcoder {
+		using From = typename SS::char_type;
+		using decoder = codec<sizeof(From)>;
+		using encoder = codec<sizeof(To)>;
+
+		struct measure {
+			size_t length;
+			size_t error;
+		};
+
+		static constexpr measure scan() {
+			measure m{0, NOT_FOUND};
+			for(size_t i = 0; i < size_t(SS::size); ) {
+				decoded d = decoder::decode(SS::data + i, SS::size - i);
+				if(d.length == 0) {
+					m.error = i;
+					return m;
+				}
+				m.length += encoder::length(d.code_point);
+				i += d.length;
+			}
+			return m;
+		}
+
+		static constexpr measure scanned = scan();
+
+		static constexpr units<To, scanned.length> build() {
+			units<To, scanned.length> result{};
+			size_t n = 0;
+			for(size_t i = 0; i < size_t(SS::size) && scanned.error == NOT_FOUND; ) {
+				decoded d = decoder::decode(SS::data + i, SS::size - i);
+				n += encoder::encode(d.code_point, result.values + n);
+				i += d.length;
+			}
+			return result;
+		}
+	};
+
+	template <typename SS, typename To, typename Indices = std::make_index_sequence<transcoder<SS, To>::scanned.length>>
+	struct transcode;
+
+	template <typename SS, typename To, size_t... I>
+	struct transcode<SS, To, std::index_sequence<I...>> {
+		static_assert(transcoder<SS, To>::scanned.error == NOT_FOUND, "invalid code unit sequence in static_string");
+
+		static constexpr auto result = transcoder<SS, To>::build();
+		using type = static_string<To, result.values[I]...>;
+	};
+
+
+	template <size_t FromSize, size_t ToSize>
+	struct ascii {
+		template <typename From, typename To>
+		static size_t copy(const From* in, size_t n, To* out) {
+			return 0;
+		}
+	};
+
+#if defined(__SSE2__)
+	template <size_t ToSize>
+	struct ascii<1, ToSize> {
+		template <typename From, typename To>
+		static size_t copy(const From* in, size_t n, To* out) {
+			size_t i = 0;
+			const __m128i zero = _mm_setzero_si128();
+			for(; n - i >= 16; i += 16) {
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				if(_mm_movemask_epi8(bytes) != 0) {
+					break;
+				}
+				__m128i low = _mm_unpacklo_epi8(bytes, zero);
+				__m128i high = _mm_unpackhi_epi8(bytes, zero);
+				if(ToSize == 2) {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), low);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), high);
+				} else {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),      _mm_unpacklo_epi16(low, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4),  _mm_unpackhi_epi16(low, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8),  _mm_unpacklo_epi16(high, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(high, zero));
+				}
+			}
+			return i;
+		}
+	};
+
+	template <>
+	struct ascii<1, 1> {
+		template <typename From, typename To>
+		static size_t copy(const From* in, size_t n, To* out) {
+			return 0;
+		}
+	};
+
+	template <>
+	struct ascii<2, 1> {
+		template <typename From, typename To>
+		static size_t copy(const From* in, size_t n, To* out) {
+			size_t i = 0;
+			const __m128i limit = _mm_set1_epi16(0x7F);
+			const __m128i zero = _mm_setzero_si128();
+			for(; n - i >= 8; i += 8) {
+				__m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m128i outside = _mm_or_si128(_mm_cmpgt_epi16(words, limit), _mm_cmplt_epi16(words, zero));
+				if(_mm_movemask_epi8(outside) != 0) {
+					break;
+				}
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(words, words));
+			}
+			return i;
+		}
+	};
+#endif
+
+
+} /* namespace utf */
+} /* namespace __impl */
+
+
+template <typename SS, typename To>
+using transcode = typename __impl::utf::transcode<SS, To>::type;
+
+
+namespace utf {
+
+
+struct result {
+	bool ok;
+	size_t read;
+	size_t written;
+};
+
+template <typename From, typename To>
+result transcode(const From* in, size_t n, To* out) {
+	using decoder = __impl::utf::codec<sizeof(From)>;
+	using encoder = __impl::utf::codec<sizeof(To)>;
+
+	size_t i = 0;
+	size_t o = 0;
+	while(i < n) {
+		size_t copied = __impl::utf::ascii<sizeof(From), sizeof(To)>::copy(in + i, n - i, out + o);
+		i += copied;
+		o += copied;
+		if(i == n) {
+			break;
+		}
+		__impl::utf::decoded d = decoder::decode(in + i, n - i);
+		if(d.length == 0) {
+			return {false, i, o};
+		}
+		o += encoder::encode(d.code_point, out + o);
+		i += d.length;
+	}
+	return {true, i, o};
+}
+
+template <typename From, typename To>
+constexpr size_t max_length(size_t n) {
+	return n * (sizeof(To) == 1 ? (sizeof(From) == 1 ? 1 : sizeof(From) == 2 ? 3 : 4)
+	          : (sizeof(To) == 2 && sizeof(From) == 4) ? 2 : 1);
+}
+
+template <typename To, typename From>
+std::basic_string<To> transcode(const std::basic_string<From>& s) {
+	std::basic_string<To> out(max_length<From, To>(s.size()), To());
+	result r = transcode(s.data(), s.size(), &out[0]);
+	if(!r.ok) {
+		throw std::range_error("invalid code unit sequence at " + std::to_string(r.read));
+	}
+	out.resize(r.written);
+	return out;
+}
+
+
+} /* namespace utf */
+
+
+} /* namespace static_string */
+
+
+#endif /* STATIC_STRINGS_UTF_HPP_ */
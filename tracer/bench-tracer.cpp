@@ -0,0 +1,146 @@
+#include "tracer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+template <typename F>
+double elapsed(F&& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+void report(const char* name, size_t events, double ns) {
+	std::printf("  %-40s %10.2f ns/event\n", name, ns / events);
+}
+
+
+// The sink that the ring buffers replace: formatting and writing on the
+// traced thread, flushing with each line.
+namespace legacy {
+
+	int enabled = 0;
+
+	std::string repeat(const std::string& s, int n) {
+		std::string str;
+		for(int i = 0; i < n; ++i) {
+			str += s;
+		}
+		return str;
+	}
+
+	void doLog(const std::string& str) {
+		std::string indent = repeat("  ", enabled);
+		std::cout << indent << str << std::endl;
+	}
+
+	void begin(const std::string& name) {
+		doLog("BEGIN " + name);
+		++enabled;
+	}
+
+	void end(const std::string& name) {
+		--enabled;
+		doLog("END " + name);
+	}
+
+} /* namespace legacy */
+
+
+namespace names {
+	TRACER_NAME(Widget, "Widget");
+	TRACER_NAME(draw, "draw");
+	TRACER_NAME(Int, "int");
+} /* namespace names */
+
+
+struct Widget {
+	static constexpr auto NAME = names::Widget;
+};
+constexpr decltype(Widget::NAME) Widget::NAME;
+
+
+// Batches of nested BEGIN/END pairs, smaller than a ring, so that the
+// producer side is measured without waiting for the drain thread.
+void benchEvents(size_t pairs) {
+	enum { DEPTH = 8, BATCH = tracing::__impl::RING_SIZE / 4 / DEPTH * DEPTH };
+	const std::string name = "Widget::draw(int)";
+	std::printf("BEGIN/END events (%zu pairs, nested %d deep)\n", pairs, int(DEPTH));
+
+	report("cout << ... << endl", 2 * pairs, elapsed([&] {
+		for(size_t k = 0; k < pairs; k += DEPTH) {
+			for(int d = 0; d < DEPTH; d++) {
+				legacy::begin(name);
+			}
+			for(int d = 0; d < DEPTH; d++) {
+				legacy::end(name);
+			}
+		}
+	}));
+
+	std::uint32_t id = tracing::intern(name);
+	double producer = 0;
+	double total = elapsed([&] {
+		for(size_t done = 0; done < pairs; done += BATCH) {
+			tracing::flush();
+			producer += elapsed([&] {
+				tracing::scope outer[DEPTH];
+				for(size_t k = 0; k < BATCH; k += DEPTH) {
+					for(int d = 0; d < DEPTH; d++) {
+						outer[d] = tracing::open(id);
+					}
+					for(int d = DEPTH; d-- > 0; ) {
+						tracing::close(outer[d], id);
+					}
+				}
+			});
+		}
+		tracing::flush();
+	});
+	report("ring buffer, traced thread", 2 * pairs, producer);
+	report("ring buffer, including the drain", 2 * pairs, total);
+
+}
+
+// Top-level Tracer<C> scopes, which log a separator too, in batches that
+// fit in a ring.
+void benchScopes(size_t scopes) {
+	enum { BATCH = tracing::__impl::RING_SIZE / 4 };
+	std::printf("Tracer<C> scopes (%zu scopes, BEGIN/END events)\n", scopes);
+
+	auto run = [scopes] {
+		double producer = 0;
+		for(size_t done = 0; done < scopes; done += BATCH) {
+			tracing::flush();
+			producer += elapsed([] {
+				for(size_t k = 0; k < BATCH; k++) {
+					Tracer<Widget> t(names::draw, names::Int);
+				}
+			});
+		}
+		tracing::flush();
+		return producer;
+	};
+	report("traced", 2 * scopes, run());
+	tracing::sampling(100);
+	report("1 in 100 sampled", 2 * scopes, run());
+	tracing::sampling(1);
+	tracing::enable(false);
+	report("disabled", 2 * scopes, run());
+	tracing::enable(true);
+}
+
+
+int main() {
+	std::ofstream null("/dev/null");
+	std::streambuf* console = std::cout.rdbuf(null.rdbuf());
+	tracing::output(null);
+	benchEvents(1 << 20);
+	benchScopes(1 << 20);
+	std::cout.rdbuf(console);
+	tracing::output(std::cout);
+}
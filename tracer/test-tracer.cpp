@@ -0,0 +1,223 @@
+#include "tracer.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace names {
+	TRACER_NAME(Widget, "Widget");
+	TRACER_NAME(draw, "draw");
+	TRACER_NAME(paint, "paint");
+	TRACER_NAME(fill, "fill");
+	TRACER_NAME(step, "step");
+	TRACER_NAME(run, "run");
+	TRACER_NAME(hidden, "hidden");
+	TRACER_NAME(ignored, "ignored");
+	TRACER_NAME(nest, "nest");
+	TRACER_NAME(Int, "int");
+} /* namespace names */
+
+
+struct Widget {
+	static constexpr auto NAME = names::Widget;
+};
+constexpr decltype(Widget::NAME) Widget::NAME;
+
+
+std::string drained(std::ostringstream& out) {
+	tracing::flush();
+	std::string text = out.str();
+	out.str("");
+	return text;
+}
+
+size_t count(const std::string& text, const std::string& line) {
+	size_t n = 0;
+	for(size_t p = text.find(line); p != std::string::npos; p = text.find(line, p + line.size())) {
+		n++;
+	}
+	return n;
+}
+
+
+void testFormat(std::ostringstream& out) {
+	Tracer<Widget>::trace(names::ignored);
+	{
+		Tracer<Widget> outer(names::draw, names::Int);
+		Tracer<Widget>::trace(names::Widget);
+		{
+			Tracer<Widget> inner(names::paint);
+		}
+	}
+	const std::string separator(80, '=');
+	assert(drained(out) ==
+		"BEGIN Widget::draw(int)\n"
+		"  Widget::Widget()  // Object is constructed!\n"
+		"  BEGIN Widget::paint()\n"
+		"  END Widget::paint()\n"
+		"END Widget::draw(int)\n"
+		+ separator + "\n");
+}
+
+// Whatever the drain thread does not take in time is dropped and counted,
+// the flush leaves room for the END.
+void testFullRing(std::ostringstream& out) {
+	const int events = 3 * tracing::__impl::RING_SIZE;
+	std::uint64_t before = tracing::dropped();
+	{
+		Tracer<Widget> t(names::fill);
+		for(int k = 0; k < events; k++) {
+			Tracer<Widget>::trace(names::step);
+		}
+		tracing::flush();
+	}
+	std::string text = drained(out);
+	std::uint64_t lost = tracing::dropped() - before;
+	assert(count(text, "  Widget::step()\n") + lost == size_t(events));
+	assert(text.find("BEGIN Widget::fill()\n") == 0);
+	assert(count(text, "END Widget::fill()\n") == 1);
+}
+
+void testExitedThread(std::ostringstream& out) {
+	std::thread([] {
+		Tracer<Widget> t(names::run);
+	}).join();
+	std::string text = drained(out);
+	assert(count(text, "BEGIN Widget::run()\n") == 1 && count(text, "END Widget::run()\n") == 1);
+	assert(drained(out).empty());
+}
+
+struct span {
+	unsigned long long parent;
+	size_t depth;
+	size_t begin;
+	size_t end;
+};
+
+// Checks the output of the spans style: every span begins once, ends once
+// at the same depth, and lies within its parent, one level deeper.
+size_t checkSpans(const std::string& text) {
+	std::map<unsigned long long, span> spans;
+	std::istringstream lines(text);
+	std::string line;
+	for(size_t k = 0; std::getline(lines, line); k++) {
+		unsigned long long id, parent;
+		int skipped = 0;
+		assert(std::sscanf(line.c_str(), "%llu %llu%n", &id, &parent, &skipped) == 2 && line[skipped] == ' ');
+		std::string rest = line.substr(skipped + 1);
+		size_t depth = rest.find_first_not_of(' ') / 2;
+		rest = rest.substr(2 * depth);
+		if(rest.compare(0, 6, "BEGIN ") == 0) {
+			assert(spans.count(id) == 0);
+			spans[id] = span{ parent, depth, k, 0 };
+		} else if(rest.compare(0, 4, "END ") == 0) {
+			assert(spans.count(id) == 1 && spans[id].end == 0);
+			assert(spans[id].parent == parent && spans[id].depth == depth);
+			spans[id].end = k;
+		}
+	}
+	for(auto& s : spans) {
+		assert(s.second.end > s.second.begin);
+		if(s.second.parent == 0) {
+			assert(s.second.depth == 0);
+		} else {
+			const span& p = spans.at(s.second.parent);
+			assert(p.begin < s.second.begin && s.second.end < p.end && p.depth + 1 == s.second.depth);
+		}
+	}
+	return spans.size();
+}
+
+void testSpans(std::ostringstream& out) {
+	tracing::output(out, tracing::style::spans);
+	{
+		Tracer<Widget> outer(names::draw);
+		Tracer<Widget>::trace(names::step);
+		Tracer<Widget> inner(names::paint);
+	}
+	tracing::enable(false);
+	{
+		Tracer<Widget> ignored(names::hidden);
+		Tracer<Widget>::trace(names::step);
+	}
+	tracing::enable(true);
+	std::string text = drained(out);
+	assert(checkSpans(text) == 2 && text.find("hidden") == std::string::npos);
+	tracing::output(out);
+}
+
+void testSampling(std::ostringstream& out) {
+	tracing::sampling(3);
+	for(int k = 0; k < 9; k++) {
+		Tracer<Widget> outer(names::draw);
+		Tracer<Widget>::trace(names::step);
+		Tracer<Widget> inner(names::paint);
+		assert(tracing::depth() == ((k + 1) % 3 == 0 ? 2 : 0));
+		assert(tracing::active() == ((k + 1) % 3 == 0));
+	}
+	tracing::sampling(1);
+	std::string text = drained(out);
+	assert(count(text, "BEGIN Widget::draw()\n") == 3 && count(text, "  Widget::step()\n") == 3);
+	assert(count(text, "BEGIN Widget::paint()\n") == 3 && count(text, std::string(80, '=')) == 3);
+	assert(!tracing::active());
+}
+
+void nest(int depth, int width) {
+	Tracer<Widget> t(names::nest);
+	Tracer<Widget>::trace(names::step);
+	for(int k = 0; depth > 0 && k < width; k++) {
+		nest(depth - 1, width);
+	}
+}
+
+// Traced threads run while another one switches tracing on and off.
+void testStress(std::ostringstream& out) {
+	enum { THREADS = 8, ROUNDS = 200 };
+	std::uint64_t before = tracing::dropped();
+	tracing::output(out, tracing::style::spans);
+	std::atomic<bool> done(false);
+	std::thread toggler([&done] {
+		for(bool on = false; !done; on = !on) {
+			tracing::enable(on);
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		tracing::enable(true);
+	});
+	std::vector<std::thread> threads;
+	for(int t = 0; t < THREADS; t++) {
+		threads.emplace_back([t] {
+			for(int k = 0; k < ROUNDS; k++) {
+				nest(1 + (t + k) % 4, 2);
+			}
+			assert(tracing::depth() == 0);
+		});
+	}
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+	done = true;
+	toggler.join();
+	checkSpans(drained(out));
+	// Each thread logs less than a ring, so none is lost.
+	assert(tracing::dropped() == before);
+	tracing::output(out);
+}
+
+
+int main() {
+	std::ostringstream out;
+	tracing::output(out);
+	testFormat(out);
+	testFullRing(out);
+	testExitedThread(out);
+	testSpans(out);
+	testSampling(out);
+	testStress(out);
+	tracing::output(std::cout);
+}
@@ -0,0 +1,560 @@
+#ifndef TRACER_HPP_
+#define TRACER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "../static-strings/static-strings.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+
+namespace tracing {
+
+
+// Defining TRACER_DISABLED compiles the spans and messages of Tracer out.
+#ifdef TRACER_DISABLED
+constexpr bool compiled = false;
+#else
+constexpr bool compiled = true;
+#endif
+
+enum class kind : std::uint8_t { begin, end, message, separator };
+
+enum class style { plain, spans };
+
+// What a traced thread writes for each event: the name is an id from
+// intern(), formatting happens later on the drain thread. span and parent
+// are the ids of the span the event belongs to and of its enclosing span,
+// 0 for none.
+struct record {
+	std::uint64_t timestamp;
+	std::uint64_t span;
+	std::uint64_t parent;
+	std::uint32_t name;
+	std::uint16_t depth;
+	kind event;
+};
+
+// The span and parent of a thread before open(), for close() to restore.
+struct scope {
+	std::uint64_t span;
+	std::uint64_t parent;
+};
+
+
+namespace __impl {
+
+
+	enum { RING_SIZE = 1 << 15, DRAIN_PERIOD_MS = 1, SPAN_BLOCK = 1 << 12 };
+
+	// The nesting state of a thread, and the block of span ids it takes
+	// new ones from. muted counts the open spans left out by sampling, and
+	// skipped the top-level spans since the last one sampled.
+	struct context {
+		std::uint16_t depth;
+		scope current;
+		std::uint64_t next;
+		std::uint64_t last;
+		unsigned muted;
+		unsigned skipped;
+	};
+
+	inline context& here() {
+		thread_local context c{};
+		return c;
+	}
+
+	inline std::atomic<bool>& switched_on() {
+		static std::atomic<bool> flag(true);
+		return flag;
+	}
+
+	inline std::atomic<unsigned>& sampling_rate() {
+		static std::atomic<unsigned> rate(1);
+		return rate;
+	}
+
+	// Timestamps only order the records, so the time stamp counter does,
+	// at a fraction of the cost of steady_clock.
+	inline std::uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+	}
+
+	// Written by its own thread only and read by the drain thread only, so
+	// head and tail are enough to hand records over without locks.
+	class ring {
+	public:
+		ring() : detached(false), head(0), tail(0), reported(0), seen_tail(0), dropped(0) {}
+
+		// new only guarantees the alignment of the padding from C++17 on.
+		static void* operator new(size_t size) {
+			void* p = nullptr;
+			if(::posix_memalign(&p, alignof(ring), size) != 0) {
+				throw std::bad_alloc();
+			}
+			return p;
+		}
+
+		static void operator delete(void* p) {
+			std::free(p);
+		}
+
+		bool push(const record& r) {
+			size_t h = head.load(std::memory_order_relaxed);
+			if(h - seen_tail == RING_SIZE) {
+				seen_tail = tail.load(std::memory_order_acquire);
+				if(h - seen_tail == RING_SIZE) {
+					return false;
+				}
+			}
+			slots[h & (RING_SIZE - 1)] = r;
+			head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+
+		template <typename F>
+		void drain(F&& f) {
+			size_t t = tail.load(std::memory_order_relaxed);
+			size_t h = head.load(std::memory_order_acquire);
+			for(; t != h; t++) {
+				f(slots[t & (RING_SIZE - 1)]);
+			}
+			tail.store(t, std::memory_order_release);
+		}
+
+		// Counts a record that did not fit, on the producer side.
+		void drop() {
+			dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		// The records dropped since the last call, on the consumer side.
+		std::uint64_t take_dropped() {
+			std::uint64_t total = dropped.load(std::memory_order_relaxed);
+			std::uint64_t recent = total - reported;
+			reported = total;
+			return recent;
+		}
+
+		bool empty() const {
+			return head.load(std::memory_order_acquire) == tail.load(std::memory_order_relaxed);
+		}
+
+		// Set when the thread exits, so that the ring goes once drained.
+		std::atomic<bool> detached;
+
+	private:
+		alignas(64) std::atomic<size_t> head;
+		alignas(64) std::atomic<size_t> tail;
+		std::uint64_t reported;
+		// The producer's last look at tail, so that it only reads the
+		// consumer's cache line when the ring seems full.
+		alignas(64) size_t seen_tail;
+		std::atomic<std::uint64_t> dropped;
+		record slots[RING_SIZE];
+	};
+
+	class names {
+	public:
+		std::uint32_t intern(const std::string& name) {
+			std::lock_guard<std::mutex> lock(mutex);
+			auto found = ids.find(name);
+			if(found != ids.end()) {
+				return found->second;
+			}
+			list.push_back(name);
+			ids.emplace(name, std::uint32_t(list.size() - 1));
+			return std::uint32_t(list.size() - 1);
+		}
+
+		template <typename F>
+		void with(F&& f) {
+			std::lock_guard<std::mutex> lock(mutex);
+			f(list);
+		}
+
+	private:
+		std::mutex mutex;
+		std::vector<std::string> list;
+		std::unordered_map<std::string, std::uint32_t> ids;
+	};
+
+	class backend {
+	public:
+		static backend& instance() {
+			static backend b;
+			return b;
+		}
+
+		~backend() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+			wakeup.notify_one();
+			worker.join();
+			flush();
+		}
+
+		// A full ring drops the record rather than make the traced thread
+		// wait for the drain, which may itself wait on a slow stream.
+		void push(const record& r) {
+			ring& mine = local();
+			if(!mine.push(r)) {
+				mine.drop();
+			}
+		}
+
+		// Unique ids, handed out to threads SPAN_BLOCK at a time.
+		std::uint64_t span_block() {
+			return spans.fetch_add(SPAN_BLOCK, std::memory_order_relaxed);
+		}
+
+		std::uint32_t intern(const std::string& name) {
+			thread_local std::unordered_map<std::string, std::uint32_t> cache;
+			auto found = cache.find(name);
+			if(found != cache.end()) {
+				return found->second;
+			}
+			std::uint32_t id = table.intern(name);
+			cache.emplace(name, id);
+			return id;
+		}
+
+		void output(std::ostream& out, style format) {
+			std::lock_guard<std::mutex> lock(drain_mutex);
+			stream = &out;
+			layout = format;
+		}
+
+		void flush() {
+			std::lock_guard<std::mutex> lock(drain_mutex);
+			drain();
+		}
+
+		std::uint64_t dropped() {
+			std::lock_guard<std::mutex> lock(drain_mutex);
+			return lost;
+		}
+
+	private:
+		struct holder {
+			std::shared_ptr<ring> owned;
+
+			~holder() {
+				if(owned) {
+					owned->detached.store(true, std::memory_order_release);
+				}
+			}
+		};
+
+		backend() : stream(&std::cout), layout(style::plain), lost(0), spans(1), stopping(false), worker([this] { loop(); }) {}
+
+		ring& local() {
+			thread_local holder mine;
+			if(!mine.owned) {
+				mine.owned = std::shared_ptr<ring>(new ring);
+				std::lock_guard<std::mutex> lock(rings_mutex);
+				rings.push_back(mine.owned);
+			}
+			return *mine.owned;
+		}
+
+		void loop() {
+			std::unique_lock<std::mutex> lock(mutex);
+			while(!stopping) {
+				wakeup.wait_for(lock, std::chrono::milliseconds(DRAIN_PERIOD_MS));
+				lock.unlock();
+				flush();
+				lock.lock();
+			}
+		}
+
+		// Records of different threads are merged by timestamp, batch by
+		// batch: the output is in time order as far as the drain can tell.
+		void drain() {
+			batch.clear();
+			{
+				std::lock_guard<std::mutex> lock(rings_mutex);
+				for(size_t k = 0; k < rings.size(); k++) {
+					rings[k]->drain([this](const record& r) {
+						batch.push_back(r);
+					});
+					lost += rings[k]->take_dropped();
+					if(rings[k]->detached.load(std::memory_order_acquire) && rings[k]->empty()) {
+						rings.erase(rings.begin() + k--);
+					}
+				}
+			}
+			if(batch.empty()) {
+				return;
+			}
+			std::stable_sort(batch.begin(), batch.end(), [](const record& a, const record& b) {
+				return a.timestamp < b.timestamp;
+			});
+			text.clear();
+			table.with([this](const std::vector<std::string>& list) {
+				for(const record& r : batch) {
+					if(layout == style::spans) {
+						text += std::to_string(r.span);
+						text += ' ';
+						text += std::to_string(r.parent);
+						text += ' ';
+					}
+					if(r.event == kind::separator) {
+						text.append(80, '=');
+					} else {
+						text.append(2 * size_t(r.depth), ' ');
+						text += (r.event == kind::begin) ? "BEGIN " : (r.event == kind::end) ? "END " : "";
+						text += list[r.name];
+					}
+					text += '\n';
+				}
+			});
+			stream->write(text.data(), text.size());
+			stream->flush();
+		}
+
+		names table;
+		std::mutex rings_mutex;
+		std::vector<std::shared_ptr<ring>> rings;
+		std::mutex drain_mutex;
+		std::vector<record> batch;
+		std::string text;
+		std::ostream* stream;
+		style layout;
+		std::uint64_t lost;
+		std::atomic<std::uint64_t> spans;
+		std::mutex mutex;
+		std::condition_variable wakeup;
+		bool stopping;
+		std::thread worker;
+	};
+
+
+} /* namespace __impl */
+
+
+inline std::uint32_t intern(const std::string& name) {
+	return __impl::backend::instance().intern(name);
+}
+
+// Whether new spans are traced, on by default. Spans already open when it
+// is switched off still log their end.
+inline bool enabled() {
+	return __impl::switched_on().load(std::memory_order_relaxed);
+}
+
+inline void enable(bool on) {
+	__impl::switched_on().store(on, std::memory_order_relaxed);
+}
+
+// Traces one in every n top-level spans of each thread, with all that is
+// nested in them. 1, the default, traces them all.
+inline void sampling(unsigned n) {
+	__impl::sampling_rate().store(n > 0 ? n : 1, std::memory_order_relaxed);
+}
+
+inline unsigned sampling() {
+	return __impl::sampling_rate().load(std::memory_order_relaxed);
+}
+
+// The number of spans open on the calling thread.
+inline int depth() {
+	return __impl::here().depth;
+}
+
+// Whether the calling thread is in a traced span, one that was not left out
+// by sampling.
+inline bool active() {
+	__impl::context& c = __impl::here();
+	return c.depth > 0 && c.muted == 0;
+}
+
+// Decides whether the next span of the calling thread is traced. When it is
+// not, the span and those nested in it are muted until unmute() ends it.
+inline bool sample() {
+	__impl::context& c = __impl::here();
+	if(c.muted == 0) {
+		if(c.depth > 0) {
+			return true;
+		}
+		if(++c.skipped >= sampling()) {
+			c.skipped = 0;
+			return true;
+		}
+	}
+	c.muted++;
+	return false;
+}
+
+inline void unmute() {
+	__impl::here().muted--;
+}
+
+// Begins a span of the calling thread, nested in its current one.
+inline scope open(std::uint32_t name) {
+	__impl::context& c = __impl::here();
+	__impl::backend& b = __impl::backend::instance();
+	if(c.next == c.last) {
+		c.next = b.span_block();
+		c.last = c.next + __impl::SPAN_BLOCK;
+	}
+	scope outer = c.current;
+	c.current = scope{ c.next++, outer.span };
+	b.push(record{ __impl::now(), c.current.span, c.current.parent, name, c.depth, kind::begin });
+	c.depth++;
+	return outer;
+}
+
+// Ends the current span of the calling thread, with what open() returned.
+inline void close(scope outer, std::uint32_t name) {
+	__impl::context& c = __impl::here();
+	__impl::backend& b = __impl::backend::instance();
+	c.depth--;
+	b.push(record{ __impl::now(), c.current.span, c.current.parent, name, c.depth, kind::end });
+	if(c.depth == 0) {
+		b.push(record{ __impl::now(), c.current.span, 0, 0, 0, kind::separator });
+	}
+	c.current = outer;
+}
+
+// Logs name in the current span of the calling thread, if it is traced.
+inline void message(std::uint32_t name) {
+	__impl::context& c = __impl::here();
+	if(c.depth > 0 && c.muted == 0) {
+		__impl::backend::instance().push(record{ __impl::now(), c.current.span, c.current.parent, name, c.depth, kind::message });
+	}
+}
+
+// Where the drain thread writes, std::cout by default. The spans style
+// starts lines with the span and parent ids of their record.
+inline void output(std::ostream& out, style format = style::plain) {
+	__impl::backend::instance().output(out, format);
+}
+
+// Writes all the records logged so far.
+inline void flush() {
+	__impl::backend::instance().flush();
+}
+
+// The records lost so far to full rings, as of the last drain. A thread
+// that logs more than RING_SIZE records between two drains loses the rest
+// rather than wait.
+inline std::uint64_t dropped() {
+	return __impl::backend::instance().dropped();
+}
+
+
+} /* namespace tracing */
+
+
+class TracerBase {
+protected:
+	enum state : std::uint8_t { OFF, MUTED, TRACED };
+
+	state status;
+	std::uint32_t name;
+	tracing::scope outer;
+
+	TracerBase() : status(OFF), name(0), outer{} {}
+
+	template <typename Name>
+	void begin() {
+		if(!tracing::sample()) {
+			status = MUTED;
+			return;
+		}
+		status = TRACED;
+		name = id<Name>();
+		outer = tracing::open(name);
+	}
+
+	~TracerBase() {
+		if(status == TRACED) {
+			tracing::close(outer, name);
+		} else if(status == MUTED) {
+			tracing::unmute();
+		}
+	}
+
+	// Names are interned once, the first time they are logged.
+	template <typename Name>
+	static std::uint32_t id() {
+		static const std::uint32_t value = tracing::intern(Name::string());
+		return value;
+	}
+};
+
+
+// Declares Name as a static_string value of text, to name classes and
+// methods.
+#define TRACER_NAME(Name, text) \
+	struct Name##_provider { constexpr static const char* str() { return text; } }; \
+	constexpr static_string::from_provider<Name##_provider> Name{}
+
+
+// Traces the scope of the methods of C, whose C::NAME is its name as a
+// static_string, named themselves with static_strings too:
+//     TRACER_NAME(method, "method");
+//     TRACER_NAME(Int, "int");
+//     Tracer<C> t(method, Int);
+// Their full names are built at compile time, so spans cost nothing when
+// tracing is disabled, or left out by sampling, beyond that check.
+template <typename C>
+class Tracer : TracerBase {
+	using empty = static_string::static_string<char>;
+
+	using class_name = typename std::decay<decltype(C::NAME)>::type;
+
+	struct constructed { constexpr static const char* str() { return "  // Object is constructed!"; } };
+
+	template <typename Function, typename Args>
+	using method = static_string::concat<
+		class_name,
+		static_string::static_string<char, ':', ':'>,
+		Function,
+		static_string::static_string<char, '('>,
+		Args,
+		static_string::static_string<char, ')'>,
+		typename std::conditional<static_string::equal<Function, class_name>::value,
+		                          static_string::from_provider<constructed>,
+		                          empty
+		                         >::type
+	>;
+
+public:
+	template <typename Function, typename Args = empty>
+	explicit Tracer(Function, Args = Args()) {
+		if(tracing::compiled && tracing::enabled()) {
+			begin<method<Function, Args>>();
+		}
+	}
+
+	template <typename Function, typename Args = empty>
+	static void trace(Function, Args = Args()) {
+		if(tracing::compiled && tracing::enabled() && tracing::active()) {
+			tracing::message(id<method<Function, Args>>());
+		}
+	}
+};
+
+
+#endif /* TRACER_HPP_ */
@@ -1,41 +1,38 @@
+#include "binary-literals/binary-literals.hpp"
+#include "static-literals/static-literals.hpp"
 #include <iostream>
+#include <limits>
 #include <string>
 
 
 template <unsigned long long N, char...BB>
-struct binary_literal {
-	enum { value = N };
-};
+using binary_literal = binary_literals::radix_literal<2, N, BB...>;
 
-template <unsigned long long N, char B, char...BB>
-struct binary_literal<N, B, BB...> {
-	static_assert(B == '0' || B == '1', "invalid binary digit");
-	enum {
-		value = binary_literal<(N << 1) | (B - '0'), BB...>::value
-	};
-};
+template <typename T, char...BB>
+constexpr T binary_value() {
+	static_assert(static_cast<unsigned long long>(binary_literal<0, BB...>::value)
+	              <= static_cast<unsigned long long>(std::numeric_limits<T>::max()),
+	              "binary literal does not fit in the type of its suffix");
+	return binary_literal<0, BB...>::value;
+}
 
-template <char...BB> constexpr          int       operator"" _b()    { return binary_literal<0, BB...>::value; }
-template <char...BB> constexpr unsigned int       operator"" _bU()   { return binary_literal<0, BB...>::value; }
-template <char...BB> constexpr          long      operator"" _bL()   { return binary_literal<0, BB...>::value; }
-template <char...BB> constexpr unsigned long      operator"" _bUL()  { return binary_literal<0, BB...>::value; }
-template <char...BB> constexpr          long long operator"" _bLL()  { return binary_literal<0, BB...>::value; }
-template <char...BB> constexpr unsigned long long operator"" _bULL() { return binary_literal<0, BB...>::value; }
+template <char...BB> constexpr          int       operator"" _b()    { return binary_value<         int,       BB...>(); }
+template <char...BB> constexpr unsigned int       operator"" _bU()   { return binary_value<unsigned int,       BB...>(); }
+template <char...BB> constexpr          long      operator"" _bL()   { return binary_value<         long,      BB...>(); }
+template <char...BB> constexpr unsigned long      operator"" _bUL()  { return binary_value<unsigned long,      BB...>(); }
+template <char...BB> constexpr          long long operator"" _bLL()  { return binary_value<         long long, BB...>(); }
+template <char...BB> constexpr unsigned long long operator"" _bULL() { return binary_value<unsigned long long, BB...>(); }
 
 
 unsigned long long operator"" _bULL(const char* s, size_t sz) {
-	unsigned long long value = 0;
-	for(size_t i = 0; i < sz; i++) {
-		char ch = s[i];
-		if(ch == '0') {
-			value = (value << 1);
-		} else if(ch == '1') {
-			value = (value << 1) | 1;
-		} else if(ch != '_') {
-			throw "Not a binary digit";
-		}
+	binary_literals::result r = binary_literals::parse(s, sz);
+	if(r.code == binary_literals::error::invalid_digit) {
+		throw "Not a binary digit";
+	}
+	if(r.code == binary_literals::error::overflow) {
+		throw "Too many binary digits";
 	}
-	return value;
+	return r.value;
 }
 long long     operator"" _bLL(const char* s, size_t sz) { return operator"" _bULL(s, sz); }
 unsigned long operator"" _bUL(const char* s, size_t sz) { return operator"" _bULL(s, sz); }
@@ -44,12 +41,9 @@ unsigned int  operator"" _bU(const char* s, size_t sz)  { return operator"" _bUL
 int           operator"" _b(const char* s, size_t sz)   { return operator"" _bULL(s, sz); }
 
 
-std::string operator"" _s(const char* s, size_t sz) {
-	return std::string(s, s+sz);
-}
-
-
 using namespace std;
+using namespace binary_literals::literals;
+using namespace static_literals::literals;
 
 int main() {
 	cout <<           0_b << endl;
@@ -81,7 +75,17 @@ int main() {
 	cout <<  "1101_0100__0011_0001"_b << endl;
 	cout << endl;
 	
+	cout << 1'0000000000000000000000000000000000000000000000000000000000000000'0000_bits << endl;
+	cout << 1'0000000000000000000000000000000000000000000000000000000000000000'0000_words[1] << endl;
+	cout << endl;
+	
+	cout << 0777_o << endl;
+	cout << "dead_beef"_x << endl;
+	cout << "zz_top"_b36 << endl;
+	cout << endl;
+	
 	cout << string("abc\0def").length() << endl;
 	cout << "abc\0def"_s.length() << endl;
+	cout << ("abc"_s.intern() == "abc"_s.intern()) << endl;
 	cout << endl;
 }